@@ -1,5 +1,7 @@
 #include <iostream>
 #include <filesystem>
+#include <chrono>
+#include <algorithm>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -12,14 +14,20 @@
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
+#include "engine/core/ThreadPool.h"
 #include "engine/window/Window.h"
 #include "engine/render/Shader.h"
 #include "engine/render/CubeMesh.h"
 #include "engine/render/CapsuleMesh.h"
 #include "engine/render/BoxRenderer.h"
 #include "engine/maze/Maze.h"
+#include "engine/maze/MazeBitboard.h"
+#include "engine/maze/MazeGenerator.h"
 #include "engine/maze/MazeMesh.h"
 #include "engine/maze/MazeCollider.h"
+#include "engine/maze/MazeConnectivity.h"
+#include "engine/maze/MazeFlowField.h"
+#include "engine/maze/MazeRaycast.h"
 #include "engine/scene/FPSCamera.h"
 
 #include "editor/EditorViewport.h"
@@ -90,15 +98,8 @@ static void updateCameraWithCollision(
         glm::vec3 baseOld = oldPos; baseOld.y = 0.0f;
         glm::vec3 baseDesired = desired; baseDesired.y = 0.0f;
 
-        glm::vec3 corrected = baseOld;
-
-        // Resolve X
-        corrected.x = baseDesired.x;
-        collider.resolve(corrected, PLAYER_RADIUS);
-
-        // Resolve Z
-        corrected.z = baseDesired.z;
-        collider.resolve(corrected, PLAYER_RADIUS);
+        // Swept, so fast moves stop at the wall instead of passing it
+        glm::vec3 corrected = collider.moveAndSlide(baseOld, baseDesired - baseOld, PLAYER_RADIUS);
 
         corrected.y = PLAYER_EYE_OFFSET;
         camera.setPosition(corrected);
@@ -153,15 +154,29 @@ int main()
         CubeMesh cube;
         BoxRenderer boxRenderer(cube);
 
+        ThreadPool workerPool;
+
         Maze maze(10, 10);
         maze.generate();
 
         MazeMesh mazeMesh;
-        mazeMesh.build(maze);
+        mazeMesh.build(maze, 0, 0, &workerPool);
 
         MazeCollider collider;
         collider.build(maze);
 
+        MazeBitboard mazeAnalysis;
+        bool validateMaze = true;
+
+        // Distance / next step to the exit corner for every cell
+        MazeFlowField flowField;
+        flowField.build(maze, maze.width() - 1, maze.height() - 1);
+
+        // Perfect / loops / disconnected, kept current per edit
+        MazeConnectivity connectivity;
+        connectivity.build(maze);
+        MazeConnectivity::Effect lastEdit = MazeConnectivity::Effect::Unchanged;
+
         CapsuleMesh capsuleMesh(PLAYER_RADIUS, PLAYER_HEIGHT);
 
         float mazeWidth  = maze.width()  * CELL_SIZE;
@@ -191,6 +206,9 @@ int main()
         // ---------------------------
         static glm::vec3 playerPos = glm::vec3(0.5f, PLAYER_EYE_OFFSET, 0.5f);
 
+        // Wall chunks that passed frustum culling last frame
+        size_t drawnWallChunks = 0;
+
         while (!window.shouldClose())
         {
             float now = (float)glfwGetTime();
@@ -221,10 +239,22 @@ int main()
             if (ImGui::Checkbox("Draw Maze Walls", &g_drawMazeWalls) && !g_drawMazeWalls)
             {
                 maze.clearWalls();
-                mazeMesh.build(maze);
+                mazeMesh.build(maze, 0, 0, &workerPool);
                 collider.build(maze);
+                flowField.build(maze, maze.width() - 1, maze.height() - 1);
+                connectivity.build(maze);
+                lastEdit = MazeConnectivity::Effect::Unchanged;
+                validateMaze = true;
             }
 
+            MazeMesh::Stats wallStats = mazeMesh.stats();
+            ImGui::Text("Wall Boxes: %zu (%zu walls)", wallStats.boxes, wallStats.walls);
+            ImGui::Text("Wall Vertices: %zu (unindexed %zu)", wallStats.vertices, wallStats.unindexedVertices);
+            ImGui::Text("Wall Triangles: %zu (unindexed %zu)", wallStats.triangles, wallStats.unindexedTriangles);
+            ImGui::Text("Wall Mesh: %.1f KB (unindexed %.1f KB)",
+                        wallStats.bytes / 1024.0, wallStats.unindexedBytes / 1024.0);
+            ImGui::Text("Wall Chunks Drawn: %zu / %zu", drawnWallChunks, wallStats.chunks);
+
             bool isGameMode = (mode == AppMode::Game);
             if (ImGui::Checkbox("Game Mode", &isGameMode))
             {
@@ -241,6 +271,13 @@ int main()
                 }
             }
 
+            bool distanceField = (collider.backend() == MazeCollider::Backend::DistanceField);
+            if (ImGui::Checkbox("Distance Field Collision", &distanceField))
+            {
+                collider.setBackend(distanceField ? MazeCollider::Backend::DistanceField
+                                                  : MazeCollider::Backend::Boxes, maze);
+            }
+
             // Camera info
             auto camPos = camera.position();
             ImGui::Text("Camera Pos: %.2f %.2f %.2f", camPos.x, camPos.y, camPos.z);
@@ -262,12 +299,49 @@ int main()
             ImGui::Text("Camera Distance (scroll zoom): %.2f", distance);
             ImGui::Text("Scroll Delta: %.2f", scrollDelta);
 
+            // Generator selection
+            static int generatorIndex = 0;
+            const auto& generatorNames = engine::mazeGeneratorNames();
+            static std::vector<const char*> generatorLabels;
+            if (generatorLabels.empty())
+                for (const auto& name : generatorNames)
+                    generatorLabels.push_back(name.c_str());
+
+            ImGui::Combo("Algorithm", &generatorIndex,
+                         generatorLabels.data(), static_cast<int>(generatorLabels.size()));
+
+            static bool parallelGeneration = true;
+            ImGui::Checkbox("Parallel (tiled)", &parallelGeneration);
+
+            // Seed: fixed seeds replay the same maze
+            static bool randomSeed = true;
+            static uint64_t seedValue = 0;
+            ImGui::Checkbox("Random Seed", &randomSeed);
+            if (!randomSeed)
+                ImGui::InputScalar("Seed", ImGuiDataType_U64, &seedValue);
+
             if (ImGui::Button("Regenerate Maze"))
             {
-                maze.generate();
-                mazeMesh.build(maze);
+                auto generator = engine::createMazeGenerator(generatorNames[generatorIndex]);
+                TiledMazeGenerator tiled(*generator, workerPool);
+                const MazeGenerator& selected = parallelGeneration
+                    ? static_cast<const MazeGenerator&>(tiled)
+                    : *generator;
+
+                if (randomSeed)
+                    maze.generate(selected);
+                else
+                    maze.generate(selected, seedValue);
+
+                seedValue = maze.seed();
+                mazeMesh.build(maze, 0, 0, &workerPool);
                 collider.build(maze);
+                flowField.build(maze, maze.width() - 1, maze.height() - 1);
+                connectivity.build(maze);
+                lastEdit = MazeConnectivity::Effect::Unchanged;
+                validateMaze = true;
             }
+            ImGui::Text("Maze Seed: %llu", static_cast<unsigned long long>(maze.seed()));
 
             ImGui::End();
 
@@ -297,17 +371,10 @@ int main()
                 maze.addWall(editX, editY, dir);
                 mazeMesh.editWall(maze, edit);
 
-                mazeMesh.editCell(edit.x, edit.y, maze);
-
-                switch (edit.dir) {
-                    case North: if (edit.y > 0) mazeMesh.editCell(edit.x, edit.y-1, maze); break;
-                    case West:  if (edit.x > 0) mazeMesh.editCell(edit.x-1, edit.y, maze); break;
-                    case South: if (edit.y < maze.height()-1) mazeMesh.editCell(edit.x, edit.y+1, maze); break;
-                    case East:  if (edit.x < maze.width()-1) mazeMesh.editCell(edit.x+1, edit.y, maze); break;
-                }
-
-
-                collider.build(maze); // rebuild entire collider
+                collider.editWall(maze, edit);
+                flowField.editWall(maze, edit);
+                lastEdit = connectivity.editWall(maze, edit);
+                validateMaze = true;
             }
 
             ImGui::SameLine();
@@ -321,9 +388,46 @@ int main()
                 maze.removeWall(editX, editY, dir);
                 mazeMesh.editWall(maze, edit);
 
-                collider.build(maze); // rebuild entire collider
+                collider.editWall(maze, edit);
+                flowField.editWall(maze, edit);
+                lastEdit = connectivity.editWall(maze, edit);
+                validateMaze = true;
+            }
+
+            // Validation, refreshed after every change
+            static size_t regionCount = 0;
+            static size_t reachableCells = 0;
+            static size_t deadEnds = 0;
+            static double validateMs = 0.0;
+            if (validateMaze)
+            {
+                auto start = std::chrono::steady_clock::now();
+                regionCount = mazeAnalysis.findRegions(maze).size();
+                reachableCells = mazeAnalysis.floodFill(maze, 0, 0).count();
+                deadEnds = mazeAnalysis.countDeadEnds(maze);
+                validateMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count();
+                validateMaze = false;
             }
 
+            ImGui::Separator();
+            ImGui::Text("Regions: %zu%s", regionCount, regionCount > 1 ? " (isolated cells)" : "");
+            ImGui::Text("Reachable from (0,0): %zu / %d", reachableCells, maze.width() * maze.height());
+            ImGui::Text("Dead Ends: %zu", deadEnds);
+            ImGui::Text("Validation: %.3f ms", validateMs);
+
+            uint32_t exitDistance = flowField.distance(editX, editY);
+            if (exitDistance == MazeFlowField::UNREACHABLE)
+                ImGui::Text("Exit: unreachable from cell");
+            else
+                ImGui::Text("Exit: %u steps from cell", exitDistance);
+            ImGui::Text("Flow Field Repair: %zu cells", flowField.lastRepaired());
+
+            ImGui::Text("Maze: %s (%zu regions, %zu loops)",
+                        MazeConnectivity::statusName(connectivity.status()),
+                        connectivity.regionCount(), connectivity.loopCount());
+            ImGui::Text("Last Edit: %s", MazeConnectivity::effectName(lastEdit));
+
             meshSculptTool.renderImGui();
 
             ImGui::End();
@@ -346,12 +450,21 @@ int main()
                 {
                     // Movement
                     glm::vec3 delta = fps->movementDelta(camera, dt);
-                    // Move player
-                    playerPos += delta;
 
-                    // Resolve collision on player
+                    // Move player. Swept on the ground plane, so sprinting
+                    // or a long frame stops at the wall instead of passing
+                    // it; resolve() then applies the selected backend.
                     if (g_collision)
+                    {
+                        glm::vec3 base = playerPos; base.y = 0.0f;
+                        delta.y = 0.0f;
+                        playerPos = collider.moveAndSlide(base, delta, PLAYER_RADIUS);
                         collider.resolve(playerPos, PLAYER_RADIUS);
+                    }
+                    else
+                    {
+                        playerPos += delta;
+                    }
 
                     // Now compute camera AFTER player is corrected
                     //glm::vec3 playerCenter = playerPos;
@@ -364,6 +477,22 @@ int main()
                     playerCenter.y = PLAYER_HEIGHT * 0.5f;
 
                     glm::vec3 camDir = glm::normalize(camera.forward());
+
+                    // Pull the boom in when a wall stands between the player
+                    // and the camera, unless the camera clears the wall top
+                    float horizontal = glm::length(glm::vec2(camDir.x, camDir.z));
+                    if (g_collision && horizontal > 1e-4f) {
+                        MazeRayHit hit = raycast(maze, { playerCenter.x / CELL_SIZE, playerCenter.z / CELL_SIZE,
+                                                         -camDir.x, -camDir.z,
+                                                         distance * horizontal / CELL_SIZE });
+                        if (hit.hit) {
+                            float along = hit.distance * CELL_SIZE / horizontal;
+                            float heightAtWall = playerCenter.y - camDir.y * along;
+                            if (heightAtWall < WALL_HEIGHT)
+                                distance = std::max(along - WALL_THICKNESS / horizontal, 0.0f);
+                        }
+                    }
+
                     glm::vec3 camPos = playerCenter - camDir * distance;
 
                     camera.setPosition(camPos);
@@ -422,7 +551,7 @@ int main()
                 hedgeShader.setBool("useGlow", true);
                 hedgeShader.setInt("colorMode", 0); // 0=cool, 1=warm, 2=neon
 
-                    mazeMesh.draw(hedgeShader);
+                drawnWallChunks = mazeMesh.draw(hedgeShader, camera.frustum());
             }
 
 
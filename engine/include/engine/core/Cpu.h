@@ -0,0 +1,27 @@
+#pragma once
+
+// x86-64 targets; prefetch hints are baseline there
+#if defined(__x86_64__) || defined(_M_X64)
+#define MAZE3D_X86_64 1
+#endif
+
+// AVX2 kernels are compiled one function at a time with MAZE3D_AVX2_TARGET
+// and only called once cpuHasAvx2() has confirmed the running CPU. The rest
+// of the engine stays baseline x86-64, so one binary runs on any CPU.
+// MSVC accepts AVX2 intrinsics anywhere and never auto-vectorizes to AVX2
+// without /arch, so it needs no attribute.
+#if defined(MAZE3D_AVX2) && defined(MAZE3D_X86_64)
+#define MAZE3D_AVX2_KERNELS 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define MAZE3D_AVX2_TARGET
+#else
+#define MAZE3D_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace engine {
+
+// True when the CPU and OS support AVX2. Checked once, then cached.
+bool cpuHasAvx2();
+
+} // namespace engine
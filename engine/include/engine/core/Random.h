@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+namespace engine {
+
+// SplitMix64: a counter-based generator with 8 bytes of state.
+// Output n is a fixed mix of (seed + n * gamma), so any sub-stream (tile,
+// chunk, row) can be derived from (seed, stream) in O(1) without touching
+// other streams, and results never depend on which thread asked first.
+// Meets UniformRandomBitGenerator for use with <random>.
+class SplitMix64 {
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64(uint64_t seed = 0) : m_state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()()
+    {
+        m_state += GAMMA;
+        return mix(m_state);
+    }
+
+    // Uniform in [0, bound), bound > 0. Multiply-shift instead of a divide.
+    uint32_t below(uint32_t bound)
+    {
+        return static_cast<uint32_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+    // Independent generator for sub-stream `stream` of `seed`.
+    static SplitMix64 forStream(uint64_t seed, uint64_t stream)
+    {
+        return SplitMix64(mix(seed ^ mix(stream + GAMMA)));
+    }
+
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static constexpr uint64_t GAMMA = 0x9E3779B97F4A7C15ull;
+
+    uint64_t m_state;
+};
+
+// Fisher-Yates. Unlike std::shuffle the result is the same on every
+// standard library, so seeded output is portable. Ranges are limited to
+// 2^32 elements by below().
+template <typename RandomIt>
+void randomShuffle(RandomIt first, RandomIt last, SplitMix64& rng)
+{
+    auto n = std::distance(first, last);
+    assert(static_cast<uint64_t>(n) <= UINT32_MAX);
+    for (auto i = n - 1; i > 0; --i) {
+        auto j = static_cast<decltype(i)>(rng.below(static_cast<uint32_t>(i + 1)));
+        using std::swap;
+        swap(first[i], first[j]);
+    }
+}
+
+} // namespace engine
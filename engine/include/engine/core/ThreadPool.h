@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+// Fixed set of worker threads with one task deque each. A worker runs its
+// own newest task first (LIFO, cache-warm) and, when it runs dry, steals the
+// oldest task from another worker (FIFO, usually the largest piece of work).
+// Tasks submitted from outside the pool are dealt round-robin.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(m_threads.size()); }
+
+    // From a pool thread the task goes on that worker's own deque
+    void submit(std::function<void()> task);
+
+    // Blocks until every submitted task has finished.
+    void wait();
+
+    // Runs fn(index, worker) for every index in [0, count) and blocks until
+    // done. The range is split in halves recursively, so idle workers steal
+    // big chunks and uneven work balances itself. `worker` is in [0, size())
+    // and is stable for the calling thread, for per-worker scratch buffers.
+    // Must not be called from a pool thread.
+    void parallelFor(size_t count, const std::function<void(size_t index, unsigned worker)>& fn);
+
+    // Index of the calling worker thread, or size() off the pool.
+    unsigned currentWorker() const;
+
+    // Tasks taken from another worker's deque since construction
+    size_t stealCount() const { return m_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(unsigned index);
+    void push(unsigned queue, std::function<void()> task);
+    bool popOwn(unsigned index, std::function<void()>& task);
+    bool steal(unsigned thief, std::function<void()>& task);
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+    std::atomic<size_t> m_queued{ 0 };       // sitting in a deque
+    std::atomic<size_t> m_unfinished{ 0 };   // submitted, not yet finished
+    std::atomic<unsigned> m_nextQueue{ 0 };
+    std::atomic<size_t> m_steals{ 0 };
+
+    // Sleeping and waiting only; the deques have their own locks
+    std::mutex m_mutex;
+    std::condition_variable m_taskReady;
+    std::condition_variable m_idle;
+    bool m_stopping = false;
+};
+
+} // namespace engine
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class MazeGenerator;
+
+// A maze far larger than memory, split into CHUNK_SIZE x CHUNK_SIZE chunks
+// that are paged in on demand. At most maxResidentChunks chunks are held,
+// least recently used first out, and dirty chunks are written back to a
+// backing file. Only chunks that were edited take a slot in the file, and
+// only they are indexed in memory, so memory use and file size follow the
+// working set and the edits, not the maze size.
+//
+// Every wall has a single owner, as in Maze: a cell owns its North and
+// West walls, so a chunk's East and South seams belong to its neighbours
+// and its own border bits are only set on the edge of the world. Each
+// chunk can therefore be meshed, collided with or rewritten on its own.
+class ChunkedMaze {
+public:
+    static constexpr int CHUNK_SIZE = 64;
+
+    // Opens backingFile, keeping its chunks if it was written for a maze of
+    // the same size, otherwise starting it empty. The file records how its
+    // world was generated; if that was with a generator createMazeGenerator()
+    // knows, chunks that were never written are generated again, so an
+    // edited world reopens whole. Otherwise they are fully walled until
+    // generate() is called. Throws std::runtime_error if the file cannot be
+    // opened or written; so do the calls below that write to it.
+    ChunkedMaze(int width, int height, const std::filesystem::path& backingFile,
+                size_t maxResidentChunks = 256);
+    ~ChunkedMaze();
+
+    ChunkedMaze(const ChunkedMaze&) = delete;
+    ChunkedMaze& operator=(const ChunkedMaze&) = delete;
+
+    // Chunks are generated lazily on first access: each one independently
+    // from (seed, chunk index), with one door to its North neighbour (or
+    // West, on the top chunk row), which keeps the whole world a perfect
+    // maze. Discards the backing file, unless keepEdits: then chunks already
+    // in it stay as written and only the rest come from generator. The file
+    // records generator's name and seed. generator must outlive this object.
+    void generate(const MazeGenerator& generator, uint64_t seed, bool keepEdits = false);
+
+    // Same API as Maze. Any call may page chunks in or out.
+    Maze::Cell cell(int x, int y);
+    bool hasWall(int x, int y, Direction dir);
+    void addWall(int x, int y, Direction dir);
+    void removeWall(int x, int y, Direction dir);
+
+    // Pages chunk (cx, cy) in. The reference is valid until the next call
+    // that may page.
+    const Maze& chunk(int cx, int cy);
+
+    // Writes dirty resident chunks to the backing file. A chunk that fails
+    // to write stays resident and dirty. The destructor flushes too, but
+    // can only log a failure, so call this first to catch it.
+    void flush();
+
+    // Visits resident chunks without paging anything in
+    void forEachResidentChunk(const std::function<void(int cx, int cy, const Maze& chunk)>& fn) const;
+
+    int width() const   { return m_width; }
+    int height() const  { return m_height; }
+    int chunksX() const { return m_chunksX; }
+    int chunksY() const { return m_chunksY; }
+
+    size_t residentChunks() const { return m_resident.size(); }
+    size_t memoryBytes() const;
+
+private:
+    struct Resident {
+        Maze maze;
+        int cx, cy;
+        bool dirty;
+        std::list<int64_t>::iterator lru;
+    };
+
+    bool inBounds(int x, int y) const;
+    int64_t chunkIndex(int cx, int cy) const { return static_cast<int64_t>(cy) * m_chunksX + cx; }
+
+    Resident& page(int cx, int cy);
+    void load(Resident& chunk);
+    void generateChunk(Resident& chunk);
+    void store(const Resident& chunk);
+    void openBackingFile(bool discard);
+    void writeHeader();
+    std::streamoff slotOffset(int64_t slot) const;
+
+    // Moves (x, y, dir) onto the cell that owns that wall
+    void toOwner(int& x, int& y, Direction& dir) const;
+    void setWall(int x, int y, Direction dir, bool on);
+
+    int m_width;
+    int m_height;
+    int m_chunksX;
+    int m_chunksY;
+    size_t m_maxResident;
+
+    const MazeGenerator* m_generator = nullptr;
+    std::unique_ptr<MazeGenerator> m_fileGenerator;   // recreated from the file header
+    uint64_t m_seed = 0;
+
+    std::filesystem::path m_path;
+    std::fstream m_file;
+    std::unordered_map<int64_t, int64_t> m_slots;  // chunk index -> file slot
+
+    std::unordered_map<int64_t, Resident> m_resident;
+    std::list<int64_t> m_lru;  // most recent first
+};
+
+} // namespace engine
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/maze/MazeSolver.h"
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class Maze;
+class ThreadPool;
+
+// HPA*: the maze is cut into clusterSize x clusterSize clusters. Every cell
+// with an opening across a cluster border is an entrance node, and each
+// cluster stores the shortest in-cluster distance between each pair of its
+// entrances. Queries search that abstract graph, then refine each hop with
+// a BFS confined to one cluster, so a long query touches a few entrances
+// per cluster instead of every cell.
+//
+// Paths are shortest among routes that stay inside a cluster between
+// entrances, which is usually, but not always, the true shortest path.
+class HierarchicalPathfinder {
+public:
+    using Step = MazeSolver::Step;
+
+    explicit HierarchicalPathfinder(int clusterSize = 32);
+
+    // Finds every cluster's entrances and distances, in parallel with a pool
+    void build(const Maze& maze, ThreadPool* pool = nullptr);
+
+    // Call after the edit has been applied to maze. A wall inside a cluster
+    // recomputes that cluster's distances; a wall on a cluster border also
+    // recomputes the entrances of the two clusters it separates.
+    void editWall(const Maze& maze, const WallEdit& edit);
+
+    // Cells from start to goal inclusive. Returns false, with path empty,
+    // when the maze is larger than MazeSolver::MAX_SIDE on a side, either
+    // end is outside the maze or goal is unreachable.
+    bool findPath(const Maze& maze, int startX, int startY, int goalX, int goalY,
+                  std::vector<Step>& path);
+
+    int clusterSize() const { return m_clusterSize; }
+    size_t nodeCount() const;
+    size_t memoryBytes() const;
+
+    // Abstract nodes expanded by the last query
+    size_t lastExpanded() const { return m_expanded; }
+
+private:
+    struct Cluster {
+        int x0, y0, width, height;
+        std::vector<uint32_t> nodes;   // entrance cells, (y << 16) | x, sorted
+        std::vector<uint16_t> dist;    // nodes x nodes, UNREACHABLE if cut off
+    };
+
+    // BFS confined to one cluster, in cluster-local cell indices
+    struct LocalSearch {
+        std::vector<uint16_t> dist;
+        std::vector<uint8_t> from;     // Direction back towards the source
+        std::vector<uint16_t> queue;
+    };
+
+    struct Record {
+        uint32_t g;
+        uint64_t parent;
+        bool closed;
+    };
+
+    struct HeapEntry {
+        uint32_t f;
+        uint32_t g;
+        uint64_t id;
+    };
+
+    int clusterIndex(int x, int y) const { return (y / m_clusterSize) * m_clustersX + x / m_clusterSize; }
+
+    void rebuildCluster(const Maze& maze, int index, bool entrances, LocalSearch& search);
+    void search(const Maze& maze, const Cluster& cluster, int x, int y, LocalSearch& search) const;
+    void appendLocalPath(const Cluster& cluster, const LocalSearch& search, int x, int y,
+                         std::vector<Step>& path) const;
+
+    int m_clusterSize;
+    int m_clustersX = 0;
+    int m_clustersY = 0;
+    std::vector<Cluster> m_clusters;
+
+    // Query scratch
+    LocalSearch m_local;
+    LocalSearch m_startSearch;
+    LocalSearch m_goalSearch;
+    std::unordered_map<uint64_t, Record> m_records;
+    std::vector<HeapEntry> m_heap;
+    std::vector<uint32_t> m_waypoints;
+    size_t m_expanded = 0;
+};
+
+} // namespace engine
@@ -1,42 +1,115 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
-#include <random>
+#include <iosfwd>
 #include "MazeTypes.h"
 
 namespace engine {
 
+class MazeGenerator;
+
+// Walls are stored once, bit-packed: every cell owns only its North and
+// West walls, held in two bit planes of 64-bit words (rows padded to whole
+// words, padding bits always zero). The East edge of the last column and
+// the South edge of the last row live in two small border bitsets.
+// That is 2 bits per cell, and every edit writes a single bit.
 class Maze {
 public:
     struct Cell {
         uint8_t walls;   // bitmask of Direction
-        bool visited;
     };
 
     Maze(int width, int height);
 
+    // Backtracker with a random seed
     void generate();
+    void generate(const MazeGenerator& generator);
+
+    // The same seed and generator always produce the same maze
+    void generate(uint64_t seed);
+    void generate(const MazeGenerator& generator, uint64_t seed);
+
+    // Seed of the last generate() call, for replaying it
+    uint64_t seed() const { return m_seed; }
+
+    // Read-only view of all four walls, assembled from the bit planes
+    Cell cell(int x, int y) const;
+    bool hasWall(int x, int y, Direction dir) const;
 
-    // Const getter for read-only access
-    const Cell& cell(int x, int y) const;
+    // Directions from (x, y) into a neighbouring cell with no wall between,
+    // as a Direction mask. For search loops; (x, y) must be in bounds.
+    uint8_t openings(int x, int y) const;
 
     // --- New: mutable helpers for editing walls ---
     void addWall(int x, int y, Direction dir);
     void removeWall(int x, int y, Direction dir);
     void clearWalls();
+    void fillWalls();
+
+    // Pastes src with its top-left cell at (x, y), clipped to this maze.
+    // Only the North and West walls of src's cells are copied; its East and
+    // South edges belong to neighbouring cells and are left alone. Whole
+    // words are copied when x is a multiple of 64.
+    void copyFrom(const Maze& src, int x, int y);
 
     int width() const  { return m_width; }
     int height() const { return m_height; }
 
+    // --- Raw rows, for word-wide queries ---
+    int wordsPerRow() const { return m_wordsPerRow; }
+    const uint64_t* northRow(int y) const { return &m_north[static_cast<size_t>(y) * m_wordsPerRow]; }
+    const uint64_t* westRow(int y) const  { return &m_west[static_cast<size_t>(y) * m_wordsPerRow]; }
+    bool eastBorder(int y) const  { return (m_east[y >> 6] >> (y & 63)) & 1u; }
+    bool southBorder(int x) const { return (m_south[x >> 6] >> (x & 63)) & 1u; }
+    const uint64_t* southBorderRow() const { return m_south.data(); }  // wordsPerRow words
+
+    // Bytes used by wall storage
+    size_t memoryBytes() const;
+
+    // Raw wall planes, exactly memoryBytes() long. Dimensions are not
+    // stored; read() expects a maze of the size that was written.
+    void write(std::ostream& out) const;
+    bool read(std::istream& in);
+
 private:
     bool inBounds(int x, int y) const;
-    int index(int x, int y) const;
-    void carve(int x, int y, std::mt19937& rng);
+
+    // Locates the single bit that stores the wall on `dir` of (x, y)
+    uint64_t* wallWord(int x, int y, Direction dir, uint64_t& mask);
+    const uint64_t* wallWord(int x, int y, Direction dir, uint64_t& mask) const;
+
+    // Mask of valid bits in word w of a row
+    uint64_t rowMask(int w) const;
 
     int m_width;
     int m_height;
-    std::vector<Cell> m_cells;
+    int m_wordsPerRow;
+    uint64_t m_seed = 0;
+
+    std::vector<uint64_t> m_north;  // height * wordsPerRow
+    std::vector<uint64_t> m_west;   // height * wordsPerRow
+    std::vector<uint64_t> m_east;   // height bits
+    std::vector<uint64_t> m_south;  // width bits
 };
 
+inline uint8_t Maze::openings(int x, int y) const
+{
+    const size_t row = static_cast<size_t>(y) * m_wordsPerRow;
+    const int word = x >> 6;
+    const uint64_t bit = 1ull << (x & 63);
+
+    uint8_t open = 0;
+    if (y > 0 && !(m_north[row + word] & bit))
+        open |= North;
+    if (y + 1 < m_height && !(m_north[row + m_wordsPerRow + word] & bit))
+        open |= South;
+    if (x > 0 && !(m_west[row + word] & bit))
+        open |= West;
+    if (x + 1 < m_width && !(m_west[row + ((x + 1) >> 6)] & (1ull << ((x + 1) & 63))))
+        open |= East;
+    return open;
+}
+
 } // namespace engine
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+class Maze;
+
+// One bit per cell, using the same row/word layout as Maze's wall planes.
+class MazeBitset {
+public:
+    MazeBitset() = default;
+    MazeBitset(int width, int height) { resize(width, height); }
+
+    // Resizes and clears
+    void resize(int width, int height);
+    void clear();
+
+    bool test(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1u; }
+    void set(int x, int y)        { row(y)[x >> 6] |= 1ull << (x & 63); }
+    void reset(int x, int y)      { row(y)[x >> 6] &= ~(1ull << (x & 63)); }
+
+    size_t count() const;
+
+    int width() const  { return m_width; }
+    int height() const { return m_height; }
+    int wordsPerRow() const { return m_wordsPerRow; }
+
+    uint64_t* row(int y)             { return &m_words[static_cast<size_t>(y) * m_wordsPerRow]; }
+    const uint64_t* row(int y) const { return &m_words[static_cast<size_t>(y) * m_wordsPerRow]; }
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_wordsPerRow = 0;
+    std::vector<uint64_t> m_words;
+};
+
+// Connectivity and wall statistics computed 64 cells at a time from the
+// maze's bit planes. Scratch buffers are kept between calls so repeated
+// queries (e.g. after every editor edit) do not allocate. Dead-end and
+// density sweeps use AVX2 when the engine is built with it and the CPU
+// supports it.
+class MazeBitboard {
+public:
+    struct Region {
+        int x, y;       // first cell in row-major order
+        size_t cells;
+    };
+
+    // Cells reachable from (x, y). Valid until the next query.
+    const MazeBitset& floodFill(const Maze& maze, int x, int y);
+
+    // Cells with exactly three walls
+    size_t countDeadEnds(const Maze& maze) const;
+
+    // Every connected region, largest first. A perfect maze has one.
+    const std::vector<Region>& findRegions(const Maze& maze);
+
+    // Fraction of each row's / column's North and West walls that are set
+    void rowWallDensity(const Maze& maze, std::vector<float>& out) const;
+    void columnWallDensity(const Maze& maze, std::vector<float>& out);
+
+private:
+    // Floods from (x, y) into m_reached; returns the number of new cells
+    size_t fill(const Maze& maze, int x, int y);
+
+    MazeBitset m_reached;
+    std::vector<uint32_t> m_work;      // word indices with new bits
+    std::vector<Region> m_regions;
+    std::vector<uint64_t> m_counters;  // bit-sliced column counters
+    std::vector<uint32_t> m_columnCounts;
+};
+
+} // namespace engine
@@ -1,37 +1,162 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <span>
 #include <vector>
 #include <glm/glm.hpp>
 
+#include "engine/maze/MazeDistanceField.h"
+#include "engine/maze/MazeTypes.h"
+#include "engine/maze/MazeWallRuns.h"
+
 namespace engine {
 
 class Maze;
 
+// Wall boxes indexed by cell: every cell has four fixed slots (N, S, W, E),
+// so a query tests only the cells a sphere overlaps and costs the same on
+// any maze size. Each side of a straight run of walls (see MazeWallRuns)
+// is one box, copied into the slot of every cell along it, so a sphere
+// sliding along a corridor meets no seams between walls. An edit rewrites
+// only the slots of the runs on the edited wall's line that it joined or
+// split.
+// Boxes are kept as structure-of-arrays (x and z extents; every wall spans
+// the same height), slot = cell * 4 + side, empty slots inverted so they
+// never collide. A row of cells is then contiguous, and on CPUs with AVX2
+// eight slots are rejected per instruction before any scalar test.
+//
+// The DistanceField backend resolves spheres against a baked
+// MazeDistanceField instead: one sample and a push along its gradient,
+// the same cost however the walls are laid out, with corners rounded off.
 class MazeCollider {
 public:
+    enum class Backend {
+        Boxes,          // exact box push-out
+        DistanceField   // sample + gradient push-out, kept in step with edits
+    };
+
     struct AABB {
         glm::vec3 min;
         glm::vec3 max;
     };
 
+    // First contact of a moving sphere
+    struct SweepHit {
+        bool hit = false;
+        float time = 1.0f;          // fraction of the motion before contact
+        glm::vec3 position{ 0.0f }; // where the sphere stops, just short of contact
+        glm::vec3 normal{ 0.0f };   // wall normal at contact, in the xz plane
+        glm::vec3 slide{ 0.0f };    // the rest of the motion along the wall
+    };
+
 public:
-    void build(const Maze& maze);
+    // origin places cell (0, 0) of maze at that world cell
+    void build(const Maze& maze, int originX = 0, int originY = 0);
+
+    // Call after the edit has been applied to maze, once per edit
+    void editWall(const Maze& maze, const WallEdit& edit);
+
+    // Switching to DistanceField bakes the field from maze, which must be
+    // the maze last built. Only resolve() uses the backend; sweep() and
+    // moveAndSlide() always use the boxes.
+    void setBackend(Backend backend, const Maze& maze, int samplesPerCell = 4);
+    Backend backend() const { return m_backend; }
+    static const char* backendName(Backend backend);
 
-    // resolves collision for a sphere
+    // Empty unless the DistanceField backend is selected
+    const MazeDistanceField& distanceField() const { return m_field; }
+
+    // resolves collision for a sphere. Tests the boxes of the cells the
+    // sphere overlaps, in slot order; for spheres that fit a corridor
+    // (radius under 0.4 cells) no box that touches it is missed.
     void resolve(
         glm::vec3& position,
         float radius
     ) const;
 
+    // Same result as resolve(), one box at a time. Reference for the SIMD
+    // path, and what resolve() runs on CPUs without AVX2.
+    void resolveScalar(glm::vec3& position, float radius) const;
+
+    // Crowds: resolves positions[i] with radii[i], or one shared radius
+    void resolve(std::span<glm::vec3> positions, std::span<const float> radii) const;
+    void resolve(std::span<glm::vec3> positions, float radius) const;
+
+    // Continuous collision: moves a sphere from start by delta and reports
+    // the first wall it touches. Cells along the motion are walked with a
+    // DDA, so cost grows with the distance moved, not the maze; nothing is
+    // skipped however far one step goes. Motion is swept in the xz plane at
+    // the start height (walls are vertical and all the same height).
+    SweepHit sweep(const glm::vec3& start, const glm::vec3& delta, float radius) const;
+
+    // Sweeps and slides along walls up to maxSlides times; returns the end
+    // position. Use instead of resolve() for long or fast steps.
+    glm::vec3 moveAndSlide(const glm::vec3& start, const glm::vec3& delta, float radius,
+                           int maxSlides = 3) const;
+
+    // The slide loop behind moveAndSlide(), over any sweep of the moving
+    // sphere, so every collision source slides the same way
+    using SweepFn = std::function<SweepHit(const glm::vec3& start, const glm::vec3& delta)>;
+    static glm::vec3 slide(const glm::vec3& start, const glm::vec3& delta, int maxSlides,
+                           const SweepFn& sweep);
+
+    // Every box once, in slot order (copied out of the slots)
+    std::vector<AABB> walls() const;
+    size_t wallCount() const { return m_wallCount; }
+
+    size_t memoryBytes() const;
+
 private:
-    bool sphereIntersectsAABB(
-        const glm::vec3& center,
-        float radius,
-        const AABB& box
-    ) const;
+    // Cells whose boxes can reach a sphere at pos, clamped to the maze
+    bool window(const glm::vec3& pos, float radius, int& x0, int& y0, int& x1, int& y1) const;
+
+    // resolveScalar() with an AVX2 prefilter; only called when the CPU
+    // has AVX2
+    void resolveAvx2(glm::vec3& position, float radius) const;
+
+    // Starts loading the slots a later resolve at pos will read
+    void prefetch(const glm::vec3& pos, float radius) const;
+
+    bool touches(size_t slot, const glm::vec3& center, float radius) const;
+
+    // Earliest time in [0, 1] a circle of radius r (xz plane) moving from p
+    // by d touches the box in slot; false if it does not
+    bool sweepSlot(size_t slot, const glm::vec2& p, const glm::vec2& d, float r,
+                   float& time, glm::vec2& normal) const;
+
+    // Whether slot, of cell (x, y), is a later copy of a run's box already
+    // tested in the window starting at cell (x0, y0)
+    bool repeated(size_t slot, int x, int y, int x0, int y0) const;
+
+    // Pushes the sphere out of the box in slot along its smallest axis
+    void pushOut(size_t slot, glm::vec3& center, float radius) const;
+
+    void setSlot(size_t slot, const AABB& box);
+    void clearSlot(size_t slot);
+    bool hasSlot(size_t slot) const { return m_minX[slot] <= m_maxX[slot]; }
+
+    // Writes (or clears) both sides of a run's box into the slots of every
+    // cell along it
+    void writeRun(const WallRun& run, bool set);
+
+    size_t cellIndex(int x, int y) const { return static_cast<size_t>(y) * m_width + x; }
 
 private:
-    std::vector<AABB> m_walls;
+    // 4 per cell plus SIMD padding
+    std::vector<float> m_minX;
+    std::vector<float> m_maxX;
+    std::vector<float> m_minZ;
+    std::vector<float> m_maxZ;
+    size_t m_wallCount = 0;
+
+    Backend m_backend = Backend::Boxes;
+    MazeDistanceField m_field;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_originX = 0;
+    int m_originY = 0;
 };
 
 } // namespace engine
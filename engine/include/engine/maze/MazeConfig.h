@@ -3,10 +3,12 @@
 namespace engine {
 
 struct MazeConfig {
-    truct MazeConfig {
     float cellSize      = 1.0f;
     float wallHeight    = 1.0f;
     float wallThickness = 0.1f;
+
+    // A ceiling rests on the walls, so their tops can never be seen
+    bool ceiling = false;
 };
 
 } // namespace engine
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class Maze;
+
+// Tracks whether a maze is still perfect (every cell reachable, no loops)
+// as walls are edited, without a flood fill per edit.
+// Open passages form a graph over the cells. A spanning forest of it is
+// held in a link-cut tree; the remaining open passages are non-tree edges,
+// each closing exactly one loop. Then
+//   - removing a wall either links two trees (regions joined) or adds a
+//     non-tree edge (loop introduced), after one connectivity query;
+//   - adding a wall on a non-tree edge just drops it (loop broken);
+//   - adding a wall on a tree edge cuts the tree, and any non-tree edge now
+//     spanning the two halves is promoted to reconnect them. Only if none
+//     does was a region isolated.
+// Tree operations are amortized O(log n). The replacement search after a
+// cut grows both halves of the tree one cell at a time, alternately, until
+// either runs out; that half is the smaller, and any loop edge leaving it
+// is a replacement. Cells have at most four passages, so that costs
+// O(min(|A|, |B|)) for halves A and B. With few loops it is cheaper to
+// test each loop edge's ends instead, so the growth stops at a budget
+// proportional to the loop count and falls back to that. A cut costs
+// O(log n + min(|A|, |B|, loops * log n)).
+class MazeConnectivity {
+public:
+    enum class Status {
+        Perfect,        // one region, no loops
+        HasLoops,       // one region
+        Disconnected    // more than one region
+    };
+
+    enum class Effect {
+        Unchanged,
+        RegionsJoined,
+        LoopIntroduced,
+        LoopBroken,
+        RegionIsolated
+    };
+
+    // Spanning forest by BFS, O(cells)
+    void build(const Maze& maze);
+
+    // Call after the edit has been applied to maze
+    Effect editWall(const Maze& maze, const WallEdit& edit);
+
+    bool connected(int ax, int ay, int bx, int by);
+
+    Status status() const;
+    size_t regionCount() const { return m_cells - m_treeEdges; }
+    size_t loopCount() const { return m_nonTree.size(); }
+
+    size_t memoryBytes() const;
+
+    static const char* statusName(Status status);
+    static const char* effectName(Effect effect);
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // An edge is keyed by the cell that owns the wall: cell * 2, +1 for West
+    static uint32_t edgeKey(uint32_t owner, bool west) { return owner * 2 + (west ? 1 : 0); }
+
+    // --- Link-cut tree over cells ---
+    bool isSplayRoot(uint32_t x) const;
+    void pushFlip(uint32_t x);
+    void rotate(uint32_t x);
+    void splay(uint32_t x);
+    void access(uint32_t x);
+    void makeRoot(uint32_t x);
+    uint32_t findRoot(uint32_t x);
+    void link(uint32_t a, uint32_t b);
+    void cut(uint32_t a, uint32_t b);
+
+    // Looks for a non-tree edge reconnecting the halves of a just-cut tree
+    // holding a and b, and links it in
+    bool reconnect(uint32_t a, uint32_t b);
+
+    // Replacement search by growing the halves; false if it gave up after
+    // `budget` cells. key is NONE when there is no replacement.
+    bool searchHalves(uint32_t a, uint32_t b, size_t budget, uint32_t& key);
+
+    // Replacement search over every non-tree edge
+    uint32_t scanLoops();
+
+    int m_width = 0;
+    size_t m_cells = 0;
+    size_t m_treeEdges = 0;
+
+    std::vector<uint32_t> m_child;    // two per cell, left/right in the splay tree
+    std::vector<uint32_t> m_up;       // splay parent, or path parent at a splay root
+    std::vector<uint8_t> m_flip;      // pending subtree reversal
+    std::vector<uint8_t> m_open;      // North/West passages mirrored from the maze
+    std::vector<uint8_t> m_loop;      // the subset of m_open that are non-tree edges
+
+    std::unordered_set<uint32_t> m_nonTree;   // the same edges, by key
+
+    std::vector<uint32_t> m_stack;    // splay scratch
+
+    // Replacement search scratch. A cell is on side s of the current
+    // search when its mark is m_search + s.
+    std::vector<uint32_t> m_mark;
+    uint32_t m_search = 0;
+    std::vector<uint32_t> m_half[2];
+};
+
+} // namespace engine
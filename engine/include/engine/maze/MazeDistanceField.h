@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class Maze;
+
+// Signed distance to the nearest wall box, baked on a 2D grid of samples
+// (samplesPerCell per cell edge, one cell of margin around the maze).
+// The walls are the same boxes MazeCollider builds. Distances are stored
+// as 16-bit fixed point and clamped to maxDistance(), so a wall edit only
+// changes samples within that distance of the wall; those are re-baked a
+// tile at a time. A query reads the four samples around a point and
+// interpolates both distance and gradient, whatever the maze looks like.
+class MazeDistanceField {
+public:
+    // Samples per side of a tile, the unit edits re-bake
+    static constexpr int TILE = 16;
+
+    // origin places cell (0, 0) of maze at that world cell
+    void build(const Maze& maze, int samplesPerCell = 4, int originX = 0, int originY = 0);
+
+    // Call after the edit has been applied to maze. Returns the number of
+    // tiles re-baked.
+    size_t editWall(const Maze& maze, const WallEdit& edit);
+
+    // Signed distance in the xz plane from (x, z) to the nearest wall,
+    // negative inside one. maxDistance() off the field or far from walls.
+    float distance(float x, float z) const;
+
+    // Distance as above, and its gradient (points away from the nearest
+    // wall; zero where the field is flat)
+    float sample(float x, float z, glm::vec2& gradient) const;
+
+    // Pushes a sphere out along the gradient until it clears the walls.
+    // Corners are rounded by the interpolation, so motion slides smoothly
+    // round them. At 4 samples per cell a sphere may still overlap the
+    // exact boxes by a few hundredths of a cell; finer fields overlap less.
+    // Radii must be under maxDistance().
+    void resolve(glm::vec3& position, float radius) const;
+    void resolve(std::span<glm::vec3> positions, std::span<const float> radii) const;
+    void resolve(std::span<glm::vec3> positions, float radius) const;
+
+    float maxDistance() const;
+    int samplesPerCell() const { return m_samplesPerCell; }
+    size_t tileCount() const { return static_cast<size_t>(m_tilesX) * m_tilesZ; }
+
+    size_t memoryBytes() const;
+
+private:
+    // Recomputes samples [i0, i1) x [j0, j1)
+    void bake(const Maze& maze, int i0, int j0, int i1, int j1);
+
+    // Starts loading the samples a later resolve at pos will read
+    void prefetch(const glm::vec3& pos) const;
+
+    size_t sampleIndex(int i, int j) const { return static_cast<size_t>(j) * m_samplesX + i; }
+
+private:
+    std::vector<int16_t> m_samples;   // row-major, m_samplesX * m_samplesZ
+
+    int m_samplesPerCell = 0;
+    int m_samplesX = 0;
+    int m_samplesZ = 0;
+    int m_tilesX = 0;
+    int m_tilesZ = 0;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_originX = 0;
+    int m_originY = 0;
+};
+
+} // namespace engine
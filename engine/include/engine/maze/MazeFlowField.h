@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class Maze;
+
+// Distance to one goal cell from every cell, plus the direction of the next
+// step towards it, so any number of agents steer with one array lookup each.
+// The next steps form a shortest-path tree rooted at the goal, which lets
+// wall edits be repaired locally instead of rebuilt:
+//   - removing a wall lowers distances outward from the new opening;
+//   - adding a wall only affects the subtree hanging off the cut edge,
+//     which is re-seeded from its intact border and re-propagated.
+class MazeFlowField {
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+    // Full BFS from the goal
+    void build(const Maze& maze, int goalX, int goalY);
+
+    // Call after the edit has been applied to maze
+    void editWall(const Maze& maze, const WallEdit& edit);
+
+    uint32_t distance(int x, int y) const { return m_dist[index(x, y)]; }
+
+    // Direction to move from (x, y); 0 at the goal or when unreachable
+    uint8_t nextStep(int x, int y) const { return m_next[index(x, y)]; }
+
+    int goalX() const { return m_goalX; }
+    int goalY() const { return m_goalY; }
+
+    // Cells whose distance was recomputed by the last edit
+    size_t lastRepaired() const { return m_repaired; }
+
+private:
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * m_width + x; }
+
+    // Lowers distances outward from cell `to`, now reachable from `from`
+    void lower(const Maze& maze, uint32_t from, uint32_t to, Direction toFrom);
+
+    // Recomputes the subtree whose tree path runs through `root`
+    void raise(const Maze& maze, uint32_t root);
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_goalX = 0;
+    int m_goalY = 0;
+
+    std::vector<uint32_t> m_dist;
+    std::vector<uint8_t> m_next;    // Direction, 0 = none
+
+    // Repair scratch
+    std::vector<uint32_t> m_queue;
+    std::vector<uint8_t> m_inSubtree;
+    std::vector<uint64_t> m_heap;   // (distance << 32) | cell, min-heap
+    size_t m_repaired = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/core/Random.h"
+
+namespace engine {
+
+class Maze;
+class ThreadPool;
+
+// A perfect-maze carving algorithm.
+// generate() expects every wall closed (Maze::generate does that) and
+// removes walls until every cell is reachable by exactly one path.
+class MazeGenerator {
+public:
+    virtual ~MazeGenerator() = default;
+
+    virtual const char* name() const = 0;
+
+    virtual void generate(Maze& maze, SplitMix64& rng) const = 0;
+
+    // Working memory beyond the maze itself, in bytes.
+    virtual size_t scratchBytes(int width, int height) const = 0;
+};
+
+// Depth-first random walk with an explicit stack.
+// O(n) time, long winding corridors. Up to 4 bytes/cell of stack.
+class BacktrackerGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "backtracker"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Randomized Kruskal over a shuffled edge list with union-find.
+// O(n a(n)) time, 16 bytes/cell, random access into the parent table.
+class KruskalGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "kruskal"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Randomized Prim growing from a frontier list.
+// O(n) time, many short dead ends. Up to 4 bytes/cell of frontier.
+class PrimGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "prim"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Loop-erased random walks: a uniform spanning tree.
+// Unbiased but slow; the first walks wander for a long time. 1 byte/cell.
+class WilsonGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "wilson"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Eller's row-by-row set merging.
+// O(n) time, O(width) memory, a single top-to-bottom pass.
+class EllerGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "eller"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Each cell opens North or West. O(n) time, O(1) memory, strongly biased
+// (open corridors along the top row and left column).
+class BinaryTreeGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "binary-tree"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Row runs that each open one passage North. O(n) time, O(1) memory,
+// open corridor along the top row.
+class SidewinderGenerator : public MazeGenerator {
+public:
+    const char* name() const override { return "sidewinder"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+};
+
+// Splits the maze into tiles, carves each with `inner` on the pool, then
+// joins the tiles through a random spanning tree over the tile grid with one
+// door per tree edge, so the result is still a perfect maze. The tile size
+// is rounded up to a multiple of 64 cells.
+class TiledMazeGenerator : public MazeGenerator {
+public:
+    TiledMazeGenerator(const MazeGenerator& inner, ThreadPool& pool, int tileSize = 256);
+
+    const char* name() const override { return "tiled"; }
+    void generate(Maze& maze, SplitMix64& rng) const override;
+    size_t scratchBytes(int width, int height) const override;
+
+private:
+    const MazeGenerator& m_inner;
+    ThreadPool& m_pool;
+    int m_tileSize;
+};
+
+// Cheap coin flips: one engine call per 64 flips.
+class RandomBits {
+public:
+    explicit RandomBits(SplitMix64& rng) : m_rng(rng) {}
+
+    bool next()
+    {
+        if (m_left == 0) {
+            m_bits = m_rng();
+            m_left = 64;
+        }
+        bool bit = m_bits & 1u;
+        m_bits >>= 1;
+        --m_left;
+        return bit;
+    }
+
+private:
+    SplitMix64& m_rng;
+    uint64_t m_bits = 0;
+    int m_left = 0;
+};
+
+// Returns nullptr for unknown names.
+std::unique_ptr<MazeGenerator> createMazeGenerator(const std::string& name);
+
+const std::vector<std::string>& mazeGeneratorNames();
+
+} // namespace engine
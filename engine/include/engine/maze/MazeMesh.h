@@ -1,51 +1,203 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <cstdint>
 #include <vector>
-#include <map>
-#include <utility>
 #include <glm/glm.hpp>
 
+#include "engine/maze/MazeConfig.h"
 #include "engine/maze/MazeTypes.h"
+#include "engine/maze/MazeWallRuns.h"
 
 namespace engine {
 
+class Frustum;
 class Maze;
 class Shader;
+class ThreadPool;
 
-struct WallEdit {
-    int x;
-    int y;
-    Direction dir;
-    bool add;
-};
-
-struct CellRange {
-    size_t offset;  // float offset in m_vertices
-    size_t count;   // float count
-};
-
+// Walls in square chunks of CHUNK_CELLS cells a side, each with its own
+// buffers and bounding box, so a frame draws only the chunks the camera
+// can see and an edit re-uploads only the chunks it changed.
+//
+// Within a chunk, wall boxes sit in fixed-size slots: 8 corner vertices
+// and a fixed run of indices per slot. Each maximal straight run of walls
+// (see MazeWallRuns), cut at chunk edges, is one box in one slot, and
+// every wall the maze can have (North and West of each cell, plus the
+// South and East borders) maps to its run's slot or to none. Live slots
+// are kept packed at the front: a new run takes the next slot, and a
+// removed run's slot is filled by moving the last one into it. An edit
+// joins or splits the runs on one line, so it touches a handful of slots,
+// and only those bytes are sent to the GPU.
+//
+// Only faces that can be seen are indexed. Boxes run half a thickness
+// past each end vertex, so walls meeting there overlap: an end cap is
+// buried in (or flush with) any other wall at that vertex and is dropped.
+// Bottoms rest on the floor and are never drawn; tops are dropped when
+// the config has a ceiling. Unused indices in a slot repeat one vertex.
+//
+// A build meshes each chunk from its own cells alone: one pass counts its
+// runs, its buffers are sized once, and a second pass writes every slot in
+// place. Chunks only read the maze, so with a pool they mesh in parallel,
+// and the result is the same for any thread count.
 class MazeMesh {
 public:
-    MazeMesh();
+    static constexpr int CHUNK_CELLS = 32;
+
+    // Geometry of the live runs, and of the same walls as one box of 36
+    // unindexed vertices (12 triangles) each
+    struct Stats {
+        size_t chunks = 0;
+        size_t walls = 0;
+        size_t boxes = 0;
+        size_t vertices = 0;
+        size_t triangles = 0;          // visible, excluding slot padding
+        size_t bytes = 0;              // vertex + index data of the live slots
+        size_t unindexedVertices = 0;
+        size_t unindexedTriangles = 0;
+        size_t unindexedBytes = 0;
+    };
+
+    explicit MazeMesh(const MazeConfig& config = MazeConfig{});
     ~MazeMesh();
 
-    void build(const Maze& maze);
+    MazeMesh(const MazeMesh&) = delete;
+    MazeMesh& operator=(const MazeMesh&) = delete;
+
+    // origin places cell (0, 0) of maze at that world cell, e.g. when
+    // meshing one chunk of a ChunkedMaze. With a pool the chunks are meshed
+    // across its workers; don't pass one from a pool thread.
+    void build(const Maze& maze, int originX = 0, int originY = 0, ThreadPool* pool = nullptr);
+
+    // build() in two halves: CPU-side vertices (any thread), then the GPU
+    // upload (GL thread). GL objects are created on the first upload.
+    void buildGeometry(const Maze& maze, int originX = 0, int originY = 0,
+                       ThreadPool* pool = nullptr);
+    void upload();
+
+    // Every chunk, or only those whose bounds meet frustum; returns the
+    // number of chunks drawn
     void draw(Shader& shader) const;
+    size_t draw(Shader& shader, const Frustum& frustum) const;
 
+    // Call after the edit has been applied to maze. Replaces the runs the
+    // wall joined or split, updates the end caps of runs that meet it, and
+    // uploads just the slots that changed. Runs are diffed against the
+    // maze, so pass every edit, one at a time, as it happens.
     void editWall(const Maze& maze, const WallEdit& edit);
     void editCell(int x, int y, const Maze& maze);
 
+    size_t wallCount() const { return m_wallCount; }
+    size_t boxCount() const;
+    size_t chunkCount() const { return m_chunks.size(); }
+    Stats stats() const;
+
+    // Bytes sent by the last editWall/editCell (0 for a no-op edit)
+    size_t lastUploadBytes() const { return m_lastUploadBytes; }
+
 private:
-    void rebuildCell(int x, int y, const Maze& maze);
+    static constexpr uint32_t NO_SLOT = ~0u;
+    static constexpr size_t NO_WALL = ~size_t(0);
+
+    struct Chunk {
+        glm::vec3 min{ 0.0f };          // bounds of every box it can hold
+        glm::vec3 max{ 0.0f };
+
+        std::vector<float> vertices;            // live slots, packed
+        std::vector<uint32_t> indices;
+        std::vector<uint8_t> slotTriangles;     // visible triangles per slot
+        std::vector<WallRun> slotRun;           // slot -> run
+        std::vector<uint32_t> dirtyVertices;    // slots changed since the last upload
+        std::vector<uint32_t> dirtyIndices;
+        size_t triangles = 0;
+    };
+
+    struct ChunkBuffers {
+        unsigned int vao = 0;
+        unsigned int vbo = 0;
+        unsigned int ebo = 0;
+        GLsizei indexCount = 0;
+        size_t slots = 0;               // slots the buffers have room for
+    };
+
+    // Slot table index of the wall on `dir` of (x, y); East and South are
+    // the neighbour's West and North, or a border wall
+    size_t wallIndex(int x, int y, Direction dir) const;
+
+    // Walls on grid lines: horizontal from (col, line) to (col + 1, line),
+    // vertical from (line, row) to (line, row + 1). NO_WALL off the maze.
+    size_t horizontalWall(int col, int line) const;
+    size_t verticalWall(int row, int line) const;
+
+    // Slot table index of wall `at` of a run's line
+    size_t runWall(const WallRun& run, int at) const;
+
+    // Chunk holding wall `at` of a run's line. A horizontal line belongs
+    // to the chunk row below it and a vertical one to the column right of
+    // it; the South and East borders to the last row and column.
+    uint32_t chunkOf(const WallRun& run, int at) const;
+
+    // Build passes for one chunk: count its runs, size it, write its boxes
+    // and wall slots; then, once every chunk has its slots, its indices.
+    // Returns the chunk's wall count.
+    size_t meshChunk(const Maze& maze, uint32_t chunk);
+    void indexChunk(uint32_t chunk);
+
+    // Whether a wall outside run meets grid vertex (vx, vz)
+    bool postTaken(int vx, int vz, const WallRun& run) const;
+
+    // The two grid vertices at the ends of a run
+    static void runEnds(const WallRun& run, int& ax, int& az, int& bx, int& bz);
+
+    // Brings the runs through the wall on `dir` of (x, y) in line with
+    // maze; returns whether it changed
+    bool syncWall(int x, int y, Direction dir, const Maze& maze);
+
+    // Takes the next slot of the run's chunk and writes its box, but not
+    // its indices
+    uint32_t addRun(const WallRun& run);
+    void freeSlot(uint32_t chunk, uint32_t slot);
+
+    // Re-indexes the runs meeting either end of a one-wall segment
+    void refreshEnds(const WallRun& segment);
+
+    void writeBox(uint32_t chunk, uint32_t slot);
+    void boxVertices(const WallRun& run, float* out) const;
+
+    // Rewrites the slot's indices from the current caps; marks it dirty
+    // only if they changed
+    void writeIndices(uint32_t chunk, uint32_t slot);
+
+    // The slot's m_indicesPerSlot indices, padded; returns the faces kept
+    int slotIndices(const WallRun& run, uint32_t slot, uint32_t* out) const;
+
+    // Queues a changed slot for the next upload
+    void markDirty(uint32_t chunk, std::vector<uint32_t>& dirty, uint32_t slot);
+
+    // Sends the dirty slots of the dirty chunks with glBufferSubData, or a
+    // whole chunk when its buffers have to grow
+    void uploadDirty();
+    void uploadChunk(uint32_t chunk);
+    void uploadRuns(const ChunkBuffers& gpu, GLenum target, std::vector<uint32_t>& dirty,
+                    size_t slots, size_t slotBytes, const void* data);
+    bool drawChunk(uint32_t chunk) const;
+
+    MazeConfig m_config;
+    size_t m_indicesPerSlot = 0;
 
-    unsigned int m_vao = 0;
-    unsigned int m_vbo = 0;
-    GLsizei m_vertexCount = 0;
+    int m_width = 0;
+    int m_height = 0;
+    int m_originX = 0;
+    int m_originY = 0;
+    int m_chunksX = 0;
 
-    std::vector<float> m_vertices;
+    std::vector<Chunk> m_chunks;
+    std::vector<ChunkBuffers> m_buffers;    // GL side, one per chunk once uploaded
+    std::vector<uint32_t> m_dirtyChunks;
+    size_t m_lastUploadBytes = 0;
 
-    std::map<std::pair<int,int>, CellRange> m_cellRanges;
+    std::vector<uint32_t> m_wallSlot;       // wall -> its run's slot in its chunk, NO_SLOT if absent
+    size_t m_wallCount = 0;
 };
 
 } // namespace engine
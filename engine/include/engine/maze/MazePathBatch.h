@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "engine/maze/MazeSolver.h"
+
+namespace engine {
+
+class Maze;
+class ThreadPool;
+
+struct PathQuery {
+    int startX;
+    int startY;
+    int goalX;
+    int goalY;
+};
+
+// Results of a batch: every path back to back in one step array, indexed by
+// query. An unreachable query has an empty path.
+class PathArena {
+public:
+    size_t size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    size_t totalSteps() const { return m_steps.size(); }
+
+    std::span<const MazeSolver::Step> path(size_t query) const
+    {
+        return { m_steps.data() + m_offsets[query], m_offsets[query + 1] - m_offsets[query] };
+    }
+    bool found(size_t query) const { return m_offsets[query + 1] != m_offsets[query]; }
+
+    size_t memoryBytes() const
+    {
+        return m_steps.capacity() * sizeof(MazeSolver::Step) + m_offsets.capacity() * sizeof(size_t);
+    }
+
+private:
+    friend class MazeBatchSolver;
+
+    std::vector<MazeSolver::Step> m_steps;
+    std::vector<size_t> m_offsets;   // size() + 1 entries
+};
+
+// Solves many (start, goal) pairs on one maze across a ThreadPool. Each
+// worker keeps its own MazeSolver and step buffer between batches, so a
+// warmed-up solver does not allocate per query; paths are gathered into the
+// arena in query order once every worker is done.
+// The maze must not change while solve() runs.
+class MazeBatchSolver {
+public:
+    explicit MazeBatchSolver(ThreadPool& pool, MazeSolver::Method method = MazeSolver::Method::AStar);
+    ~MazeBatchSolver();
+
+    // Returns the number of queries with a path; none on a maze larger than
+    // MazeSolver::MAX_SIDE on a side
+    size_t solve(const Maze& maze, std::span<const PathQuery> queries, PathArena& arena);
+
+    MazeSolver::Method method() const { return m_method; }
+    void setMethod(MazeSolver::Method method) { m_method = method; }
+
+    // Cells expanded across the last batch
+    size_t lastExpanded() const;
+
+    size_t scratchBytes() const;
+
+private:
+    struct alignas(64) Worker {
+        MazeSolver solver;
+        std::vector<MazeSolver::Step> path;
+        std::vector<MazeSolver::Step> steps;   // this worker's paths, back to back
+        size_t expanded = 0;
+    };
+
+    // Where a query's path landed
+    struct Slot {
+        uint32_t worker;
+        uint32_t length;
+        size_t offset;
+    };
+
+    ThreadPool& m_pool;
+    MazeSolver::Method m_method;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<Slot> m_slots;
+};
+
+} // namespace engine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class Maze;
+
+// Rays over the maze grid, in cell units: cell (x, y) spans [x, x+1) x
+// [y, y+1), and walls are the zero-thickness lines between cells. World
+// space is the same with the maze at the origin and y as world z.
+// Cells are stepped with Amanatides-Woo and every crossing reads one wall
+// bit straight from the Maze, so a ray costs a few instructions per cell
+// and nothing depends on how many walls the maze has.
+struct MazeRay {
+    float x;
+    float y;
+    float dirX;          // need not be normalized
+    float dirY;
+    float maxDistance;   // along the normalized direction
+};
+
+struct MazeRayHit {
+    bool hit = false;
+    float distance = 0.0f;   // to the wall, or how far the ray got
+    int cellX = -1;          // cell whose side was hit
+    int cellY = -1;
+    Direction wall = North;  // side of that cell
+};
+
+// First wall along the ray. A ray from outside the maze enters through the
+// border; one that leaves through an open border stops there without a hit.
+MazeRayHit raycast(const Maze& maze, const MazeRay& ray);
+
+// Many rays; hits[i] for rays[i]
+void raycast(const Maze& maze, std::span<const MazeRay> rays, std::span<MazeRayHit> hits);
+
+// True when no wall crosses the segment from a to b
+bool lineOfSight(const Maze& maze, float ax, float ay, float bx, float by);
+
+} // namespace engine
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <random>
+#include <vector>
+
+#include "engine/core/Random.h"
+#include "engine/maze/Maze.h"
+
+namespace engine {
+
+// Eller's algorithm as an unbounded row stream.
+// Only the current row's sets are kept, so memory is O(width) no matter how
+// many rows are produced. Rows use the same wall bitmask as Maze::Cell, and
+// each row's North walls match the South walls of the row before it, so
+// consecutive rows (or chunks) can be handed to MazeMesh / MazeCollider
+// independently.
+class MazeRowStream {
+public:
+    using RowSink = std::function<void(uint64_t y, const Maze::Cell* cells, int width)>;
+
+    explicit MazeRowStream(int width, uint64_t seed = std::random_device{}());
+
+    // Produces the next row. Pass last = true to close the maze: every set
+    // is joined and the South border is walled. The stream is then finished.
+    const std::vector<Maze::Cell>& nextRow(bool last = false);
+
+    // Emits `rows` rows to sink, closing the maze on the final one.
+    void generate(uint64_t rows, const RowSink& sink);
+
+    // Fills every row of chunk; closes the maze after it if `last`.
+    void fillChunk(Maze& chunk, bool last = false);
+
+    // Binary dump: "MZR1", uint32 width, uint64 rows, then one wall byte
+    // per cell, row-major.
+    void write(std::ostream& out, uint64_t rows);
+
+    int width() const { return m_width; }
+    uint64_t rowsEmitted() const { return m_rowsEmitted; }
+    bool finished() const { return m_finished; }
+
+    // Working memory, in bytes.
+    size_t stateBytes() const;
+
+private:
+    uint32_t find(uint32_t c);
+
+    int m_width;
+    SplitMix64 m_rng;
+    uint64_t m_rowsEmitted = 0;
+    bool m_finished = false;
+
+    std::vector<uint32_t> m_parent;
+    std::vector<uint32_t> m_carried;  // root column in the row above, or NONE
+    std::vector<uint32_t> m_leader;   // first column per carried set
+    std::vector<uint32_t> m_members;  // reservoir counters per set
+    std::vector<uint32_t> m_chosen;
+    std::vector<uint8_t>  m_hasDown;
+    std::vector<uint8_t>  m_down;
+
+    std::vector<Maze::Cell> m_row;
+};
+
+} // namespace engine
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine/maze/MazeBitboard.h"
+
+namespace engine {
+
+class Maze;
+
+// Shortest paths on a Maze, read straight from its wall planes.
+// All scratch is flat and kept between queries: one parent byte per cell,
+// bitset closed sets, and a single cell queue that doubles as the list of
+// touched cells, so a query clears only what it visited. Once warmed up on
+// a maze size, queries do not allocate (pass the same path vector back in).
+// One solver per thread.
+class MazeSolver {
+public:
+    enum class Method {
+        BFS,
+        Bidirectional,   // BFS from both ends, level by level
+        AStar            // Manhattan heuristic
+    };
+
+    // Cells are 16-bit coordinates, so mazes are limited to MAX_SIDE cells
+    // on a side
+    static constexpr int MAX_SIDE = 0xffff;
+    static bool supports(int width, int height) { return width <= MAX_SIDE && height <= MAX_SIDE; }
+
+    struct Step {
+        uint16_t x;
+        uint16_t y;
+    };
+
+    // Sizes scratch for width x height up front instead of on first use.
+    // Returns false, reserving nothing, when supports() rejects the size.
+    bool reserve(int width, int height);
+
+    // Cells from start to goal inclusive. Returns false, with path empty,
+    // when the maze is larger than MAX_SIDE on a side, either end is outside
+    // the maze or goal is unreachable.
+    bool findPath(const Maze& maze, int startX, int startY, int goalX, int goalY,
+                  std::vector<Step>& path, Method method = Method::AStar);
+
+    // Cells expanded by the last query
+    size_t lastExpanded() const { return m_expanded; }
+
+    size_t scratchBytes() const;
+
+    static const char* methodName(Method method);
+
+private:
+    // Cells are packed as (y << 16) | x in the queue and heap
+    struct HeapEntry {
+        uint32_t f;
+        uint32_t g;
+        uint32_t cell;
+        uint8_t from;    // Direction back towards start
+    };
+
+    bool bfs(const Maze& maze, uint32_t start, uint32_t goal);
+    bool bidirectional(const Maze& maze, uint32_t start, uint32_t goal, uint32_t& meet);
+    bool astar(const Maze& maze, uint32_t start, uint32_t goal);
+
+    // Follows parents (low or high nibble) from cell to the search root
+    void trace(const Maze& maze, uint32_t cell, int shift, std::vector<Step>& path) const;
+
+    std::vector<uint8_t> m_parent;     // Direction to step back; bidirectional keeps the goal side in the high nibble
+    MazeBitset m_closed;
+    MazeBitset m_closedGoal;           // bidirectional only
+    std::vector<uint32_t> m_queue;
+    std::vector<HeapEntry> m_heap;
+
+    size_t m_expanded = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeCollider.h"
+#include "engine/maze/MazeMesh.h"
+
+namespace engine {
+
+class Frustum;
+class MazeGenerator;
+class Shader;
+class ThreadPool;
+
+// Infinite maze streamed in CHUNK_SIZE x CHUNK_SIZE chunks around a focus
+// point. A chunk is a pure function of (seed, cx, cy), so it can be
+// dropped behind the player and rebuilt identically later. Worker threads
+// generate each chunk's maze, vertices and collider; the main thread only
+// uploads finished meshes.
+//
+// As in ChunkedMaze, a chunk owns its North and West seams and leaves its
+// East and South seams to its neighbours, so neighbours never disagree
+// about a shared wall. Each chunk opens one door in each of its seams,
+// which keeps every chunk reachable from every other.
+class MazeStreamer {
+public:
+    static constexpr int CHUNK_SIZE = 32;
+
+    // generatorName as accepted by createMazeGenerator
+    MazeStreamer(ThreadPool& pool, uint64_t seed, int loadRadius = 3,
+                 const std::string& generatorName = "backtracker");
+    ~MazeStreamer();
+
+    MazeStreamer(const MazeStreamer&) = delete;
+    MazeStreamer& operator=(const MazeStreamer&) = delete;
+
+    // Main thread, once per frame. Queues missing chunks within loadRadius
+    // of focus (nearest first), drops chunks beyond loadRadius + 1 and
+    // uploads at most maxUploads finished chunks.
+    void update(const glm::vec3& focus, int maxUploads = 2);
+
+    // Every loaded chunk, or only the wall chunks inside frustum
+    void draw(Shader& shader) const;
+    void draw(Shader& shader, const Frustum& frustum) const;
+
+    // Resolves a sphere against the loaded chunks around it
+    void resolve(glm::vec3& position, float radius) const;
+
+    // Continuous collision against the loaded chunks: the earliest hit of
+    // every chunk the motion passes near, so a step across a seam still
+    // stops at the first wall. Chunks not loaded have no walls.
+    MazeCollider::SweepHit sweep(const glm::vec3& start, const glm::vec3& delta, float radius) const;
+
+    // As MazeCollider::moveAndSlide, across chunks
+    glm::vec3 moveAndSlide(const glm::vec3& start, const glm::vec3& delta, float radius,
+                           int maxSlides = 3) const;
+
+    // Loaded chunk (cx, cy), or nullptr
+    const Maze* chunk(int cx, int cy) const;
+
+    static glm::ivec2 chunkAt(const glm::vec3& position);
+
+    // Fills maze (CHUNK_SIZE square) with chunk (cx, cy) of the world
+    static void generateChunk(Maze& maze, const MazeGenerator& generator,
+                              uint64_t seed, int cx, int cy);
+
+    uint64_t seed() const { return m_shared->seed; }
+    int loadRadius() const { return m_loadRadius; }
+    size_t loadedChunks() const  { return m_loaded.size(); }
+    size_t pendingChunks() const { return m_pending.size(); }
+
+private:
+    struct Chunk {
+        int cx, cy;
+        Maze maze{ CHUNK_SIZE, CHUNK_SIZE };
+        MazeMesh mesh;
+        MazeCollider collider;
+        std::atomic<bool> cancelled{ false };
+    };
+
+    // Everything a worker job touches. Jobs hold their own reference, so
+    // the streamer never has to wait for them.
+    struct Shared {
+        std::unique_ptr<MazeGenerator> generator;
+        uint64_t seed = 0;
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Chunk>> finished;
+    };
+
+    static int64_t key(int cx, int cy)
+    {
+        return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    void request(int cx, int cy);
+
+    ThreadPool& m_pool;
+    int m_loadRadius;
+    std::shared_ptr<Shared> m_shared;
+
+    std::unordered_map<int64_t, std::shared_ptr<Chunk>> m_loaded;
+    std::unordered_map<int64_t, std::shared_ptr<Chunk>> m_pending;
+
+    glm::ivec2 m_center{ 0, 0 };
+    bool m_hasCenter = false;
+};
+
+} // namespace engine
@@ -8,3 +8,16 @@ enum Direction : uint8_t {
     South = 1 << 2,
     West  = 1 << 3
 };
+
+namespace engine {
+
+// One wall change, passed to the subsystems that update incrementally
+// after Maze::addWall / removeWall
+struct WallEdit {
+    int x;
+    int y;
+    Direction dir;
+    bool add;
+};
+
+} // namespace engine
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <functional>
+
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+class Maze;
+
+// A straight run of walls along one grid line. Horizontal runs lie on
+// z = line and cover columns [begin, end); vertical runs lie on x = line
+// and cover rows [begin, end). Line height() is the South border and
+// line width() the East border.
+struct WallRun {
+    bool horizontal = true;
+    int line = 0;
+    int begin = 0;
+    int end = 0;
+
+    int length() const { return end - begin; }
+    bool empty() const { return end <= begin; }
+};
+
+// Every maximal run once: horizontal runs line by line, then vertical runs
+// in the order their last row is reached
+void forEachWallRun(const Maze& maze, const std::function<void(const WallRun&)>& fn);
+
+// The walls the cells [x0, x1) x [y0, y1) own: their North and West walls,
+// plus the South and East borders where the window reaches them. Runs are
+// cut to the window; horizontal ones come first, line by line, then
+// vertical ones. Windows that tile the maze visit every wall once.
+void forEachWallRun(const Maze& maze, int x0, int y0, int x1, int y1,
+                    const std::function<void(const WallRun&)>& fn);
+
+// The grid line and position of the wall on `dir` of (x, y)
+WallRun wallSegment(const WallEdit& edit);
+
+// How an edit changed the maximal runs on the edited wall's line: the
+// runs through that spot before it and after it. Adding a wall joins up
+// to two runs into one; removing splits one. Reads maze after the edit
+// has been applied; unused entries are empty.
+struct WallRunEdit {
+    WallRun before[2];
+    WallRun after[2];
+};
+
+WallRunEdit wallRunEdit(const Maze& maze, const WallEdit& edit);
+
+} // namespace engine
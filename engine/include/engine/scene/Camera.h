@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include "Frustum.h"
 
 namespace engine
 {
@@ -19,6 +20,9 @@ public:
     virtual glm::vec3 position() const = 0;
     virtual glm::vec3 forward() const = 0;
 
+    // What view() and projection() currently see, for culling
+    Frustum frustum() const { return Frustum(projection() * view()); }
+
 
 };
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace engine {
+
+// The six clip planes of a projection * view matrix, for culling boxes.
+// A default-constructed frustum contains everything.
+class Frustum {
+public:
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    // False only when the box is entirely outside one plane. A box near a
+    // corner of the frustum may be kept; a visible one is never dropped.
+    bool intersects(const glm::vec3& min, const glm::vec3& max) const;
+
+private:
+    // xyz is the inward normal (not normalized), w the offset
+    glm::vec4 m_planes[6]{};
+};
+
+} // namespace engine
@@ -0,0 +1,37 @@
+#include "engine/core/Cpu.h"
+
+#if defined(MAZE3D_X86_64) && defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+bool detectAvx2()
+{
+#if !defined(MAZE3D_X86_64)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    // OSXSAVE and AVX (leaf 1), YMM state enabled by the OS, AVX2 (leaf 7)
+    int regs[4];
+    __cpuid(regs, 1);
+    if ((regs[2] & (1 << 27 | 1 << 28)) != (1 << 27 | 1 << 28)) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+} // namespace
+
+bool cpuHasAvx2()
+{
+    static const bool supported = detectAvx2();
+    return supported;
+}
+
+} // namespace engine
@@ -0,0 +1,167 @@
+#include "engine/core/ThreadPool.h"
+
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local unsigned t_worker = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    threadCount = std::max(threadCount, 1u);
+
+    m_queues.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+
+    m_threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+        m_threads.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_taskReady.notify_all();
+
+    for (auto& t : m_threads)
+        t.join();
+}
+
+// --- Queues ---
+
+void ThreadPool::push(unsigned queue, std::function<void()> task)
+{
+    m_unfinished.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+        m_queues[queue]->tasks.push_back(std::move(task));
+    }
+    m_queued.fetch_add(1);
+
+    // Taking the lock orders this against a worker checking m_queued
+    // just before it sleeps
+    { std::lock_guard<std::mutex> lock(m_mutex); }
+    m_taskReady.notify_one();
+}
+
+bool ThreadPool::popOwn(unsigned index, std::function<void()>& task)
+{
+    WorkerQueue& q = *m_queues[index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    m_queued.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::steal(unsigned thief, std::function<void()>& task)
+{
+    const unsigned n = size();
+    for (unsigned k = 1; k < n; ++k) {
+        WorkerQueue& q = *m_queues[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        m_queued.fetch_sub(1);
+        m_steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    const unsigned queue = (t_pool == this)
+        ? t_worker
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+    push(queue, std::move(task));
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_unfinished.load() == 0; });
+}
+
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t, unsigned)>& fn)
+{
+    if (count == 0) return;
+
+    // A few chunks per worker leaves room to rebalance by stealing
+    const size_t grain = std::max<size_t>(1, count / (size_t(size()) * 8));
+
+    std::mutex doneMutex;
+    std::condition_variable done;
+    size_t remaining = count;
+
+    // Keeps the left half, pushes the right half for thieves, repeat
+    std::function<void(size_t, size_t)> run = [&](size_t begin, size_t end) {
+        while (end - begin > grain) {
+            size_t mid = begin + (end - begin) / 2;
+            submit([&run, mid, end] { run(mid, end); });
+            end = mid;
+        }
+
+        unsigned worker = currentWorker();
+        for (size_t i = begin; i < end; ++i)
+            fn(i, worker);
+
+        // Count down under the lock: the caller owns doneMutex and may
+        // return as soon as it sees zero.
+        std::lock_guard<std::mutex> lock(doneMutex);
+        remaining -= end - begin;
+        if (remaining == 0)
+            done.notify_one();
+    };
+
+    submit([&run, count] { run(0, count); });
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
+
+unsigned ThreadPool::currentWorker() const
+{
+    return t_pool == this ? t_worker : size();
+}
+
+// --- Workers ---
+
+void ThreadPool::workerLoop(unsigned index)
+{
+    t_pool = this;
+    t_worker = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (popOwn(index, task) || steal(index, task)) {
+            task();
+            task = nullptr;
+
+            if (m_unfinished.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taskReady.wait(lock, [this] { return m_stopping || m_queued.load() > 0; });
+        if (m_stopping && m_queued.load() == 0)
+            return;
+    }
+}
+
+} // namespace engine
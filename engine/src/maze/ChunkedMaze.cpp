@@ -0,0 +1,333 @@
+#include "engine/maze/ChunkedMaze.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/core/Random.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace engine {
+
+namespace {
+
+// File layout: a fixed header, then fixed-size slots appended as chunks
+// are first written. A slot is the chunk index followed by the chunk's
+// Maze::write() output, padded to the size of a full chunk. The slot index
+// is rebuilt by scanning the slots when the file is reopened.
+//
+// Header: magic, then CHUNK_SIZE, width and height as int32 (the part that
+// must match to reuse the file), then the world's seed as uint64 and its
+// generator's name, NUL-padded (empty if never generated).
+constexpr char FILE_MAGIC[4] = { 'M', 'Z', 'C', '2' };
+constexpr std::streamoff SHAPE_BYTES = 16;
+constexpr std::streamoff SEED_OFFSET = SHAPE_BYTES;
+constexpr std::streamoff NAME_OFFSET = SEED_OFFSET + sizeof(uint64_t);
+constexpr std::streamoff HEADER_BYTES = 48;
+
+std::streamoff slotBytes()
+{
+    static const std::streamoff bytes = static_cast<std::streamoff>(
+        sizeof(int64_t) + Maze(ChunkedMaze::CHUNK_SIZE, ChunkedMaze::CHUNK_SIZE).memoryBytes());
+    return bytes;
+}
+
+std::array<char, HEADER_BYTES> makeHeader(int width, int height, uint64_t seed,
+                                          const MazeGenerator* generator)
+{
+    std::array<char, HEADER_BYTES> header{};
+    const int32_t fields[3] = { ChunkedMaze::CHUNK_SIZE, width, height };
+    std::memcpy(header.data(), FILE_MAGIC, sizeof(FILE_MAGIC));
+    std::memcpy(header.data() + sizeof(FILE_MAGIC), fields, sizeof(fields));
+
+    if (generator) {
+        std::memcpy(header.data() + SEED_OFFSET, &seed, sizeof(seed));
+        const size_t room = HEADER_BYTES - NAME_OFFSET - 1;
+        std::strncpy(header.data() + NAME_OFFSET, generator->name(), room);
+    }
+    return header;
+}
+
+} // namespace
+
+ChunkedMaze::ChunkedMaze(int width, int height, const std::filesystem::path& backingFile,
+                         size_t maxResidentChunks)
+    : m_width(width), m_height(height),
+      m_chunksX((width + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      m_chunksY((height + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      m_maxResident(std::max<size_t>(maxResidentChunks, 1)),
+      m_path(backingFile)
+{
+    openBackingFile(false);
+}
+
+ChunkedMaze::~ChunkedMaze()
+{
+    // Destructors cannot throw; call flush() first to handle the error
+    try {
+        flush();
+    } catch (const std::exception& e) {
+        std::cerr << "ChunkedMaze: " << e.what() << "\n";
+    }
+}
+
+void ChunkedMaze::openBackingFile(bool discard)
+{
+    m_file.close();
+    m_slots.clear();
+    if (!discard) {
+        m_file.open(m_path, std::ios::in | std::ios::out | std::ios::binary);
+
+        const auto shape = makeHeader(m_width, m_height, 0, nullptr);
+        std::array<char, HEADER_BYTES> existing{};
+        if (m_file.read(existing.data(), HEADER_BYTES) &&
+            std::equal(shape.begin(), shape.begin() + SHAPE_BYTES, existing.begin())) {
+            // Pick up the generator the world was made with, if we have it
+            existing.back() = '\0';
+            m_fileGenerator = createMazeGenerator(existing.data() + NAME_OFFSET);
+            if (m_fileGenerator) {
+                m_generator = m_fileGenerator.get();
+                std::memcpy(&m_seed, existing.data() + SEED_OFFSET, sizeof(m_seed));
+            }
+
+            int64_t index = 0;
+            for (int64_t slot = 0;; ++slot) {
+                m_file.seekg(slotOffset(slot));
+                if (!m_file.read(reinterpret_cast<char*>(&index), sizeof(index)))
+                    break;
+                m_slots[index] = slot;
+            }
+            m_file.clear();
+            return;
+        }
+        m_file.close();
+    }
+
+    // New, mismatched or discarded: start an empty file
+    m_file.open(m_path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+        throw std::runtime_error("Failed to open chunk file at: " + m_path.string());
+    writeHeader();
+}
+
+void ChunkedMaze::writeHeader()
+{
+    const auto header = makeHeader(m_width, m_height, m_seed, m_generator);
+
+    m_file.clear();
+    m_file.seekp(0);
+    m_file.write(header.data(), HEADER_BYTES);
+    m_file.flush();
+    if (!m_file)
+        throw std::runtime_error("Failed to write chunk file header at: " + m_path.string());
+}
+
+void ChunkedMaze::generate(const MazeGenerator& generator, uint64_t seed, bool keepEdits)
+{
+    // Edits reach the file before the chunks they were made on are dropped;
+    // chunks that were never written are made again from the new generator
+    if (keepEdits)
+        flush();
+    m_resident.clear();
+    m_lru.clear();
+
+    m_generator = &generator;
+    m_fileGenerator.reset();
+    m_seed = seed;
+
+    if (keepEdits)
+        writeHeader();
+    else
+        openBackingFile(true);
+}
+
+// --- Paging ---
+
+ChunkedMaze::Resident& ChunkedMaze::page(int cx, int cy)
+{
+    const int64_t index = chunkIndex(cx, cy);
+
+    auto it = m_resident.find(index);
+    if (it != m_resident.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return it->second;
+    }
+
+    if (m_resident.size() >= m_maxResident) {
+        auto victim = m_resident.find(m_lru.back());
+        if (victim->second.dirty)
+            store(victim->second);
+        m_resident.erase(victim);
+        m_lru.pop_back();
+    }
+
+    const int w = std::min(CHUNK_SIZE, m_width - cx * CHUNK_SIZE);
+    const int h = std::min(CHUNK_SIZE, m_height - cy * CHUNK_SIZE);
+
+    m_lru.push_front(index);
+    Resident& chunk = m_resident.emplace(index, Resident{ Maze(w, h), cx, cy, false, m_lru.begin() })
+                          .first->second;
+    load(chunk);
+    return chunk;
+}
+
+std::streamoff ChunkedMaze::slotOffset(int64_t slot) const
+{
+    return HEADER_BYTES + slot * slotBytes();
+}
+
+void ChunkedMaze::load(Resident& chunk)
+{
+    auto slot = m_slots.find(chunkIndex(chunk.cx, chunk.cy));
+    if (slot != m_slots.end()) {
+        m_file.clear();
+        m_file.seekg(slotOffset(slot->second) + static_cast<std::streamoff>(sizeof(int64_t)));
+        if (chunk.maze.read(m_file))
+            return;
+        m_file.clear();
+    }
+
+    if (m_generator) {
+        generateChunk(chunk);
+        return;
+    }
+
+    // Never written: fully walled, with seams left to the neighbours
+    chunk.maze.fillWalls();
+    const int w = chunk.maze.width();
+    const int h = chunk.maze.height();
+    if ((chunk.cx + 1) < m_chunksX)
+        for (int y = 0; y < h; ++y) chunk.maze.removeWall(w - 1, y, East);
+    if ((chunk.cy + 1) < m_chunksY)
+        for (int x = 0; x < w; ++x) chunk.maze.removeWall(x, h - 1, South);
+}
+
+void ChunkedMaze::generateChunk(Resident& chunk)
+{
+    Maze& maze = chunk.maze;
+    const int w = maze.width();
+    const int h = maze.height();
+
+    SplitMix64 rng = SplitMix64::forStream(m_seed, static_cast<uint64_t>(chunkIndex(chunk.cx, chunk.cy)));
+    maze.generate(*m_generator, rng());
+
+    // East / South seams are owned by the neighbouring chunks
+    if ((chunk.cx + 1) < m_chunksX)
+        for (int y = 0; y < h; ++y) maze.removeWall(w - 1, y, East);
+    if ((chunk.cy + 1) < m_chunksY)
+        for (int x = 0; x < w; ++x) maze.removeWall(x, h - 1, South);
+
+    // One door per chunk joins the chunk trees into a single tree
+    if (chunk.cy > 0)
+        maze.removeWall(static_cast<int>(rng.below(w)), 0, North);
+    else if (chunk.cx > 0)
+        maze.removeWall(0, static_cast<int>(rng.below(h)), West);
+}
+
+void ChunkedMaze::store(const Resident& chunk)
+{
+    const int64_t index = chunkIndex(chunk.cx, chunk.cy);
+    const int64_t slot = m_slots.emplace(index, static_cast<int64_t>(m_slots.size())).first->second;
+
+    // Partial edge chunks are padded so every slot has the same size
+    static const std::vector<char> padding(static_cast<size_t>(slotBytes()));
+    const std::streamsize used = static_cast<std::streamsize>(sizeof(index) + chunk.maze.memoryBytes());
+
+    m_file.clear();
+    m_file.seekp(slotOffset(slot));
+    m_file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+    chunk.maze.write(m_file);
+    m_file.write(padding.data(), slotBytes() - used);
+
+    // The caller keeps the chunk resident and dirty, so the edits survive
+    if (!m_file)
+        throw std::runtime_error("Failed to write chunk to: " + m_path.string());
+}
+
+void ChunkedMaze::flush()
+{
+    for (auto& [index, chunk] : m_resident) {
+        if (!chunk.dirty) continue;
+        store(chunk);
+        chunk.dirty = false;
+    }
+    m_file.flush();
+    if (!m_file)
+        throw std::runtime_error("Failed to flush chunk file at: " + m_path.string());
+}
+
+const Maze& ChunkedMaze::chunk(int cx, int cy)
+{
+    return page(cx, cy).maze;
+}
+
+void ChunkedMaze::forEachResidentChunk(
+    const std::function<void(int cx, int cy, const Maze& chunk)>& fn) const
+{
+    for (const auto& [index, chunk] : m_resident)
+        fn(chunk.cx, chunk.cy, chunk.maze);
+}
+
+size_t ChunkedMaze::memoryBytes() const
+{
+    size_t bytes = m_slots.size() * 2 * sizeof(int64_t);
+    for (const auto& [index, chunk] : m_resident)
+        bytes += sizeof(Resident) + chunk.maze.memoryBytes();
+    return bytes;
+}
+
+// --- Cell access ---
+
+bool ChunkedMaze::inBounds(int x, int y) const
+{
+    return x >= 0 && y >= 0 && x < m_width && y < m_height;
+}
+
+void ChunkedMaze::toOwner(int& x, int& y, Direction& dir) const
+{
+    // Same rule as Maze: East / South are the neighbour's West / North,
+    // except on the world edge where the chunk's border bit holds them
+    if (dir == East && x + 1 < m_width)  { ++x; dir = West; }
+    if (dir == South && y + 1 < m_height) { ++y; dir = North; }
+}
+
+bool ChunkedMaze::hasWall(int x, int y, Direction dir)
+{
+    if (!inBounds(x, y)) return false;
+
+    toOwner(x, y, dir);
+    return page(x / CHUNK_SIZE, y / CHUNK_SIZE).maze.hasWall(x % CHUNK_SIZE, y % CHUNK_SIZE, dir);
+}
+
+Maze::Cell ChunkedMaze::cell(int x, int y)
+{
+    uint8_t walls = 0;
+    for (Direction dir : { North, East, South, West })
+        if (hasWall(x, y, dir)) walls |= dir;
+    return { walls };
+}
+
+void ChunkedMaze::setWall(int x, int y, Direction dir, bool on)
+{
+    if (!inBounds(x, y)) return;
+
+    toOwner(x, y, dir);
+    Resident& chunk = page(x / CHUNK_SIZE, y / CHUNK_SIZE);
+    if (on) chunk.maze.addWall(x % CHUNK_SIZE, y % CHUNK_SIZE, dir);
+    else    chunk.maze.removeWall(x % CHUNK_SIZE, y % CHUNK_SIZE, dir);
+    chunk.dirty = true;
+}
+
+void ChunkedMaze::addWall(int x, int y, Direction dir)
+{
+    setWall(x, y, dir, true);
+}
+
+void ChunkedMaze::removeWall(int x, int y, Direction dir)
+{
+    setWall(x, y, dir, false);
+}
+
+} // namespace engine
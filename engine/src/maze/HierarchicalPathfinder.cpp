@@ -0,0 +1,376 @@
+#include "engine/maze/HierarchicalPathfinder.h"
+#include "engine/maze/Maze.h"
+#include "engine/core/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace engine {
+
+namespace {
+
+constexpr uint16_t UNREACHABLE = 0xffff;
+
+// Abstract node ids: (cluster << 16) | entrance index, plus the query ends
+constexpr uint64_t START_ID = ~0ull;
+constexpr uint64_t GOAL_ID = ~0ull - 1;
+
+constexpr uint32_t pack(int x, int y) { return (static_cast<uint32_t>(y) << 16) | static_cast<uint32_t>(x); }
+constexpr int cellX(uint32_t c) { return static_cast<int>(c & 0xffffu); }
+constexpr int cellY(uint32_t c) { return static_cast<int>(c >> 16); }
+
+constexpr uint64_t nodeId(int cluster, size_t index)
+{
+    return (static_cast<uint64_t>(cluster) << 16) | index;
+}
+
+constexpr Direction DIRECTIONS[] = { North, East, South, West };
+
+Direction opposite(Direction dir)
+{
+    switch (dir) {
+        case North: return South;
+        case South: return North;
+        case West:  return East;
+        default:    return West;
+    }
+}
+
+void offset(Direction dir, int& x, int& y)
+{
+    switch (dir) {
+        case North: --y; break;
+        case South: ++y; break;
+        case West:  --x; break;
+        default:    ++x; break;
+    }
+}
+
+struct HeapOrder {
+    template <typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+        return a.f != b.f ? a.f > b.f : a.g < b.g;
+    }
+};
+
+} // namespace
+
+HierarchicalPathfinder::HierarchicalPathfinder(int clusterSize)
+    // Local searches index cells with 16 bits
+    : m_clusterSize(std::clamp(clusterSize, 4, 255))
+{
+}
+
+// --- Cluster precomputation ---
+
+void HierarchicalPathfinder::build(const Maze& maze, ThreadPool* pool)
+{
+    // Nodes are packed as MazeSolver packs cells; larger mazes stay unbuilt
+    // and every query on them fails
+    if (!MazeSolver::supports(maze.width(), maze.height())) {
+        m_clusters.clear();
+        return;
+    }
+
+    m_clustersX = (maze.width() + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (maze.height() + m_clusterSize - 1) / m_clusterSize;
+
+    m_clusters.assign(static_cast<size_t>(m_clustersX) * m_clustersY, {});
+    for (int cy = 0; cy < m_clustersY; ++cy) {
+        for (int cx = 0; cx < m_clustersX; ++cx) {
+            Cluster& c = m_clusters[static_cast<size_t>(cy) * m_clustersX + cx];
+            c.x0 = cx * m_clusterSize;
+            c.y0 = cy * m_clusterSize;
+            c.width = std::min(m_clusterSize, maze.width() - c.x0);
+            c.height = std::min(m_clusterSize, maze.height() - c.y0);
+        }
+    }
+
+    if (!pool) {
+        for (size_t i = 0; i < m_clusters.size(); ++i)
+            rebuildCluster(maze, static_cast<int>(i), true, m_local);
+        return;
+    }
+
+    std::vector<LocalSearch> scratch(pool->size() + 1);
+    pool->parallelFor(m_clusters.size(), [&](size_t index, unsigned worker) {
+        rebuildCluster(maze, static_cast<int>(index), true, scratch[worker]);
+    });
+}
+
+void HierarchicalPathfinder::rebuildCluster(const Maze& maze, int index, bool entrances,
+                                            LocalSearch& local)
+{
+    Cluster& c = m_clusters[index];
+    const int x1 = c.x0 + c.width - 1;
+    const int y1 = c.y0 + c.height - 1;
+
+    if (entrances) {
+        c.nodes.clear();
+
+        auto consider = [&](int x, int y) {
+            const uint8_t open = maze.openings(x, y);
+            if ((y == c.y0 && (open & North)) || (y == y1 && (open & South)) ||
+                (x == c.x0 && (open & West))  || (x == x1 && (open & East)))
+                c.nodes.push_back(pack(x, y));
+        };
+
+        for (int x = c.x0; x <= x1; ++x) {
+            consider(x, c.y0);
+            if (y1 != c.y0) consider(x, y1);
+        }
+        for (int y = c.y0 + 1; y < y1; ++y) {
+            consider(c.x0, y);
+            if (x1 != c.x0) consider(x1, y);
+        }
+
+        std::sort(c.nodes.begin(), c.nodes.end());
+    }
+
+    const size_t k = c.nodes.size();
+    c.dist.assign(k * k, UNREACHABLE);
+
+    for (size_t i = 0; i < k; ++i) {
+        search(maze, c, cellX(c.nodes[i]), cellY(c.nodes[i]), local);
+        for (size_t j = 0; j < k; ++j) {
+            const int lx = cellX(c.nodes[j]) - c.x0;
+            const int ly = cellY(c.nodes[j]) - c.y0;
+            c.dist[i * k + j] = local.dist[ly * c.width + lx];
+        }
+    }
+}
+
+void HierarchicalPathfinder::search(const Maze& maze, const Cluster& c, int x, int y,
+                                    LocalSearch& local) const
+{
+    const int w = c.width;
+    const size_t cells = static_cast<size_t>(w) * c.height;
+
+    local.dist.assign(cells, UNREACHABLE);
+    local.from.resize(cells);
+    local.queue.resize(cells);
+
+    const uint16_t source = static_cast<uint16_t>((y - c.y0) * w + (x - c.x0));
+    local.dist[source] = 0;
+    local.from[source] = 0;
+    local.queue[0] = source;
+
+    size_t head = 0, tail = 1;
+    while (head < tail) {
+        const uint16_t l = local.queue[head++];
+        const int lx = l % w;
+        const int ly = l / w;
+        const uint8_t open = maze.openings(c.x0 + lx, c.y0 + ly);
+
+        for (Direction dir : DIRECTIONS) {
+            if (!(open & dir)) continue;
+
+            int nx = lx, ny = ly;
+            offset(dir, nx, ny);
+            if (nx < 0 || ny < 0 || nx >= w || ny >= c.height) continue;
+
+            const uint16_t n = static_cast<uint16_t>(ny * w + nx);
+            if (local.dist[n] != UNREACHABLE) continue;
+
+            local.dist[n] = local.dist[l] + 1;
+            local.from[n] = opposite(dir);
+            local.queue[tail++] = n;
+        }
+    }
+}
+
+void HierarchicalPathfinder::appendLocalPath(const Cluster& c, const LocalSearch& local,
+                                             int x, int y, std::vector<Step>& path) const
+{
+    // Target back to (not including) the search source, then reversed
+    const size_t first = path.size();
+    int lx = x - c.x0;
+    int ly = y - c.y0;
+
+    for (uint8_t back; (back = local.from[ly * c.width + lx]) != 0; ) {
+        path.push_back({ static_cast<uint16_t>(c.x0 + lx), static_cast<uint16_t>(c.y0 + ly) });
+        offset(static_cast<Direction>(back), lx, ly);
+    }
+    std::reverse(path.begin() + first, path.end());
+}
+
+void HierarchicalPathfinder::editWall(const Maze& maze, const WallEdit& edit)
+{
+    if (m_clusters.empty()) return;
+
+    int nx = edit.x, ny = edit.y;
+    offset(edit.dir, nx, ny);
+
+    // Walls on the maze border never join two cells
+    auto inside = [&](int x, int y) { return x >= 0 && y >= 0 && x < maze.width() && y < maze.height(); };
+    if (!inside(edit.x, edit.y) || !inside(nx, ny)) return;
+
+    const int a = clusterIndex(edit.x, edit.y);
+    const int b = clusterIndex(nx, ny);
+
+    if (a == b) {
+        rebuildCluster(maze, a, false, m_local);
+    }
+    else {
+        rebuildCluster(maze, a, true, m_local);
+        rebuildCluster(maze, b, true, m_local);
+    }
+}
+
+// --- Queries ---
+
+bool HierarchicalPathfinder::findPath(const Maze& maze, int startX, int startY, int goalX, int goalY,
+                                      std::vector<Step>& path)
+{
+    path.clear();
+    m_expanded = 0;
+
+    auto inside = [&](int x, int y) { return x >= 0 && y >= 0 && x < maze.width() && y < maze.height(); };
+    if (m_clusters.empty() || !inside(startX, startY) || !inside(goalX, goalY))
+        return false;
+    if (!MazeSolver::supports(maze.width(), maze.height()))
+        return false;
+
+    const uint32_t startCell = pack(startX, startY);
+    const uint32_t goalCell = pack(goalX, goalY);
+    const int startCluster = clusterIndex(startX, startY);
+    const int goalCluster = clusterIndex(goalX, goalY);
+    const Cluster& sc = m_clusters[startCluster];
+    const Cluster& gc = m_clusters[goalCluster];
+
+    // Same cluster and connected inside it: no abstract search needed
+    search(maze, sc, startX, startY, m_startSearch);
+    if (startCluster == goalCluster &&
+        m_startSearch.dist[(goalY - sc.y0) * sc.width + (goalX - sc.x0)] != UNREACHABLE) {
+        path.push_back({ static_cast<uint16_t>(startX), static_cast<uint16_t>(startY) });
+        appendLocalPath(sc, m_startSearch, goalX, goalY, path);
+        return true;
+    }
+    search(maze, gc, goalX, goalY, m_goalSearch);
+
+    // --- A* over entrances ---
+    auto cellOf = [&](uint64_t id) {
+        if (id == START_ID) return startCell;
+        if (id == GOAL_ID) return goalCell;
+        return m_clusters[id >> 16].nodes[id & 0xffffu];
+    };
+    auto h = [&](uint32_t cell) {
+        return static_cast<uint32_t>(std::abs(cellX(cell) - goalX) + std::abs(cellY(cell) - goalY));
+    };
+    auto relax = [&](uint64_t id, uint32_t g, uint64_t parent) {
+        auto [it, inserted] = m_records.try_emplace(id, Record{ g, parent, false });
+        if (!inserted) {
+            if (it->second.closed || it->second.g <= g) return;
+            it->second.g = g;
+            it->second.parent = parent;
+        }
+        m_heap.push_back({ g + h(cellOf(id)), g, id });
+        std::push_heap(m_heap.begin(), m_heap.end(), HeapOrder{});
+    };
+    auto localDist = [](const Cluster& c, const LocalSearch& local, uint32_t cell) {
+        return local.dist[(cellY(cell) - c.y0) * c.width + (cellX(cell) - c.x0)];
+    };
+
+    m_records.clear();
+    m_heap.clear();
+    relax(START_ID, 0, START_ID);
+
+    bool found = false;
+    while (!m_heap.empty()) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), HeapOrder{});
+        const HeapEntry top = m_heap.back();
+        m_heap.pop_back();
+
+        Record& record = m_records[top.id];
+        if (record.closed || top.g > record.g) continue;
+        record.closed = true;
+        ++m_expanded;
+
+        if (top.id == GOAL_ID) { found = true; break; }
+
+        if (top.id == START_ID) {
+            for (size_t i = 0; i < sc.nodes.size(); ++i) {
+                uint16_t d = localDist(sc, m_startSearch, sc.nodes[i]);
+                if (d != UNREACHABLE) relax(nodeId(startCluster, i), d, START_ID);
+            }
+            continue;
+        }
+
+        const int ci = static_cast<int>(top.id >> 16);
+        const size_t i = top.id & 0xffffu;
+        const Cluster& c = m_clusters[ci];
+        const size_t k = c.nodes.size();
+        const uint32_t cell = c.nodes[i];
+
+        if (ci == goalCluster) {
+            uint16_t d = localDist(gc, m_goalSearch, cell);
+            if (d != UNREACHABLE) relax(GOAL_ID, top.g + d, top.id);
+        }
+
+        for (size_t j = 0; j < k; ++j) {
+            uint16_t d = c.dist[i * k + j];
+            if (j != i && d != UNREACHABLE) relax(nodeId(ci, j), top.g + d, top.id);
+        }
+
+        // Step across the cluster border
+        const uint8_t open = maze.openings(cellX(cell), cellY(cell));
+        for (Direction dir : DIRECTIONS) {
+            if (!(open & dir)) continue;
+
+            int nx = cellX(cell), ny = cellY(cell);
+            offset(dir, nx, ny);
+            const int cn = clusterIndex(nx, ny);
+            if (cn == ci) continue;
+
+            const auto& nodes = m_clusters[cn].nodes;
+            auto it = std::lower_bound(nodes.begin(), nodes.end(), pack(nx, ny));
+            if (it != nodes.end() && *it == pack(nx, ny))
+                relax(nodeId(cn, it - nodes.begin()), top.g + 1, top.id);
+        }
+    }
+
+    if (!found) return false;
+
+    // --- Refine: BFS inside one cluster per hop ---
+    m_waypoints.clear();
+    for (uint64_t id = GOAL_ID; id != START_ID; id = m_records[id].parent)
+        m_waypoints.push_back(cellOf(id));
+    m_waypoints.push_back(startCell);
+    std::reverse(m_waypoints.begin(), m_waypoints.end());
+
+    path.push_back({ static_cast<uint16_t>(startX), static_cast<uint16_t>(startY) });
+    for (size_t w = 1; w < m_waypoints.size(); ++w) {
+        const uint32_t a = m_waypoints[w - 1];
+        const uint32_t b = m_waypoints[w];
+        if (a == b) continue;
+
+        const int ca = clusterIndex(cellX(a), cellY(a));
+        if (ca != clusterIndex(cellX(b), cellY(b))) {
+            path.push_back({ static_cast<uint16_t>(cellX(b)), static_cast<uint16_t>(cellY(b)) });
+            continue;
+        }
+
+        search(maze, m_clusters[ca], cellX(a), cellY(a), m_local);
+        appendLocalPath(m_clusters[ca], m_local, cellX(b), cellY(b), path);
+    }
+    return true;
+}
+
+size_t HierarchicalPathfinder::nodeCount() const
+{
+    size_t count = 0;
+    for (const auto& c : m_clusters)
+        count += c.nodes.size();
+    return count;
+}
+
+size_t HierarchicalPathfinder::memoryBytes() const
+{
+    size_t bytes = m_clusters.capacity() * sizeof(Cluster);
+    for (const auto& c : m_clusters)
+        bytes += c.nodes.capacity() * sizeof(uint32_t) + c.dist.capacity() * sizeof(uint16_t);
+    return bytes;
+}
+
+} // namespace engine
@@ -1,20 +1,24 @@
 #include "engine/maze/Maze.h"
 
-#include <random>
 #include <algorithm>
-#include <stack>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <utility>
+#include "engine/maze/MazeGenerator.h"
 #include "engine/maze/MazeTypes.h"
 
 namespace engine {
 
 Maze::Maze(int width, int height)
     : m_width(width), m_height(height),
-      m_cells(width * height)
+      m_wordsPerRow((width + 63) / 64),
+      m_north(static_cast<size_t>(height) * m_wordsPerRow),
+      m_west(static_cast<size_t>(height) * m_wordsPerRow),
+      m_east((height + 63) / 64),
+      m_south((width + 63) / 64)
 {
-    for (auto& c : m_cells) {
-        c.walls = North | East | South | West;
-        c.visited = false;
-    }
+    fillWalls();
 }
 
 bool Maze::inBounds(int x, int y) const
@@ -22,118 +26,211 @@ bool Maze::inBounds(int x, int y) const
     return x >= 0 && y >= 0 && x < m_width && y < m_height;
 }
 
-int Maze::index(int x, int y) const
+uint64_t Maze::rowMask(int w) const
 {
-    return y * m_width + x;
+    int bits = m_width - w * 64;
+    return bits >= 64 ? ~0ull : (1ull << bits) - 1;
 }
 
-// Read-only getter
-const Maze::Cell& Maze::cell(int x, int y) const
+const uint64_t* Maze::wallWord(int x, int y, Direction dir, uint64_t& mask) const
 {
-    return m_cells[index(x, y)];
+    // East and South are the neighbour's West and North, or a border bit
+    switch (dir)
+    {
+        case North: break;
+        case West:  break;
+        case South:
+            if (y + 1 == m_height) {
+                mask = 1ull << (x & 63);
+                return &m_south[x >> 6];
+            }
+            ++y; dir = North;
+            break;
+        case East:
+            if (x + 1 == m_width) {
+                mask = 1ull << (y & 63);
+                return &m_east[y >> 6];
+            }
+            ++x; dir = West;
+            break;
+        default: return nullptr;
+    }
+
+    mask = 1ull << (x & 63);
+    size_t word = static_cast<size_t>(y) * m_wordsPerRow + (x >> 6);
+    return dir == North ? &m_north[word] : &m_west[word];
 }
 
-// --- New: editable wall helpers ---
-void Maze::addWall(int x, int y, Direction dir)
+uint64_t* Maze::wallWord(int x, int y, Direction dir, uint64_t& mask)
 {
-    if (!inBounds(x, y)) return;
+    return const_cast<uint64_t*>(std::as_const(*this).wallWord(x, y, dir, mask));
+}
+
+// Read-only getter
+Maze::Cell Maze::cell(int x, int y) const
+{
+    const size_t row = static_cast<size_t>(y) * m_wordsPerRow;
+    const int word = x >> 6;
+    const int bit = x & 63;
 
-    m_cells[index(x, y)].walls |= dir;
+    uint8_t walls = 0;
+    if ((m_north[row + word] >> bit) & 1u) walls |= North;
+    if ((m_west[row + word] >> bit) & 1u)  walls |= West;
 
-    int nx = x;
-    int ny = y;
-    Direction opposite;
+    if (x + 1 < m_width) {
+        if ((m_west[row + ((x + 1) >> 6)] >> ((x + 1) & 63)) & 1u) walls |= East;
+    }
+    else if (eastBorder(y)) {
+        walls |= East;
+    }
 
-    switch (dir)
-    {
-        case North: ny -= 1; opposite = South; break;
-        case South: ny += 1; opposite = North; break;
-        case West:  nx -= 1; opposite = East;  break;
-        case East:  nx += 1; opposite = West;  break;
-        default: return;
+    if (y + 1 < m_height) {
+        if ((m_north[row + m_wordsPerRow + word] >> bit) & 1u) walls |= South;
+    }
+    else if (southBorder(x)) {
+        walls |= South;
     }
 
-    if (inBounds(nx, ny))
-        m_cells[index(nx, ny)].walls |= opposite;
+    return { walls };
 }
 
-void Maze::removeWall(int x, int y, Direction dir)
+bool Maze::hasWall(int x, int y, Direction dir) const
 {
-    if (!inBounds(x, y)) return;
+    if (!inBounds(x, y)) return false;
 
-    m_cells[index(x, y)].walls &= ~dir;
+    uint64_t mask = 0;
+    const uint64_t* word = wallWord(x, y, dir, mask);
+    return word && (*word & mask);
+}
 
-    int nx = x;
-    int ny = y;
-    Direction opposite;
+// --- New: editable wall helpers ---
+void Maze::addWall(int x, int y, Direction dir)
+{
+    if (!inBounds(x, y)) return;
 
-    switch (dir)
-    {
-        case North: ny -= 1; opposite = South; break;
-        case South: ny += 1; opposite = North; break;
-        case West:  nx -= 1; opposite = East;  break;
-        case East:  nx += 1; opposite = West;  break;
-        default: return;
-    }
+    uint64_t mask = 0;
+    if (uint64_t* word = wallWord(x, y, dir, mask))
+        *word |= mask;
+}
+
+void Maze::removeWall(int x, int y, Direction dir)
+{
+    if (!inBounds(x, y)) return;
 
-    if (inBounds(nx, ny))
-        m_cells[index(nx, ny)].walls &= ~opposite;
+    uint64_t mask = 0;
+    if (uint64_t* word = wallWord(x, y, dir, mask))
+        *word &= ~mask;
 }
 
 void Maze::clearWalls()
 {
-    for (auto& c : m_cells)
-        c.walls = 0;
+    std::fill(m_north.begin(), m_north.end(), 0);
+    std::fill(m_west.begin(), m_west.end(), 0);
+    std::fill(m_east.begin(), m_east.end(), 0);
+    std::fill(m_south.begin(), m_south.end(), 0);
 }
 
 
-void Maze::generate()
+void Maze::fillWalls()
 {
-    std::mt19937 rng(std::random_device{}());
+    for (int y = 0; y < m_height; ++y) {
+        for (int w = 0; w < m_wordsPerRow; ++w) {
+            size_t i = static_cast<size_t>(y) * m_wordsPerRow + w;
+            m_north[i] = rowMask(w);
+            m_west[i]  = rowMask(w);
+        }
+    }
+
+    std::fill(m_east.begin(), m_east.end(), ~0ull);
+    std::fill(m_south.begin(), m_south.end(), ~0ull);
+    if (m_height & 63) m_east.back()  = (1ull << (m_height & 63)) - 1;
+    if (m_width & 63)  m_south.back() = (1ull << (m_width & 63)) - 1;
+}
 
-    for (auto& c : m_cells) {
-        c.visited = false;
-        c.walls = North | East | South | West;
+void Maze::copyFrom(const Maze& src, int x, int y)
+{
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(x + src.m_width, m_width);
+    const int y1 = std::min(y + src.m_height, m_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    if (x >= 0 && (x & 63) == 0) {
+        // Aligned: src words map onto ours one to one
+        const int firstWord = x >> 6;
+        const int words = (x1 - x + 63) / 64;
+
+        for (int dy = y0; dy < y1; ++dy) {
+            const size_t s = static_cast<size_t>(dy - y) * src.m_wordsPerRow;
+            const size_t d = static_cast<size_t>(dy) * m_wordsPerRow + firstWord;
+
+            for (int w = 0; w < words; ++w) {
+                uint64_t keep = ~0ull;
+                int bits = (x1 - x) - w * 64;
+                if (bits < 64) keep = (1ull << bits) - 1;
+
+                m_north[d + w] = (m_north[d + w] & ~keep) | (src.m_north[s + w] & keep);
+                m_west[d + w]  = (m_west[d + w] & ~keep)  | (src.m_west[s + w] & keep);
+            }
+        }
+        return;
     }
 
-    carve(0, 0, rng);
+    for (int dy = y0; dy < y1; ++dy) {
+        for (int dx = x0; dx < x1; ++dx) {
+            if (src.hasWall(dx - x, dy - y, North)) addWall(dx, dy, North);
+            else removeWall(dx, dy, North);
+
+            if (src.hasWall(dx - x, dy - y, West)) addWall(dx, dy, West);
+            else removeWall(dx, dy, West);
+        }
+    }
 }
 
-// Recursive backtracker
-void Maze::carve(int x, int y, std::mt19937& rng)
+size_t Maze::memoryBytes() const
 {
-    m_cells[index(x, y)].visited = true;
+    return (m_north.size() + m_west.size() + m_east.size() + m_south.size()) * sizeof(uint64_t);
+}
 
-    struct Step {
-        int dx, dy;
-        Direction dir;
-        Direction opposite;
-    };
+void Maze::write(std::ostream& out) const
+{
+    for (const auto* plane : { &m_north, &m_west, &m_east, &m_south })
+        out.write(reinterpret_cast<const char*>(plane->data()),
+                  static_cast<std::streamsize>(plane->size() * sizeof(uint64_t)));
+}
 
-    std::vector<Step> dirs = {
-        { 0, -1, North, South },
-        { 1,  0, East,  West  },
-        { 0,  1, South, North },
-        { -1, 0, West,  East  }
-    };
+bool Maze::read(std::istream& in)
+{
+    for (auto* plane : { &m_north, &m_west, &m_east, &m_south })
+        in.read(reinterpret_cast<char*>(plane->data()),
+                static_cast<std::streamsize>(plane->size() * sizeof(uint64_t)));
+    return static_cast<bool>(in);
+}
 
-    std::shuffle(dirs.begin(), dirs.end(), rng);
 
-    for (const auto& s : dirs) {
-        int nx = x + s.dx;
-        int ny = y + s.dy;
+void Maze::generate()
+{
+    generate(BacktrackerGenerator{});
+}
 
-        if (!inBounds(nx, ny)) continue;
+void Maze::generate(const MazeGenerator& generator)
+{
+    std::random_device device;
+    generate(generator, (uint64_t(device()) << 32) | device());
+}
 
-        auto& next = m_cells[index(nx, ny)];
-        if (next.visited) continue;
+void Maze::generate(uint64_t seed)
+{
+    generate(BacktrackerGenerator{}, seed);
+}
 
-        // remove walls between cells
-        m_cells[index(x, y)].walls &= ~s.dir;
-        next.walls &= ~s.opposite;
+void Maze::generate(const MazeGenerator& generator, uint64_t seed)
+{
+    m_seed = seed;
+    SplitMix64 rng(seed);
 
-        carve(nx, ny, rng);
-    }
+    fillWalls();
+    generator.generate(*this, rng);
 }
 
 } // namespace engine
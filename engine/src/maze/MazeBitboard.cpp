@@ -0,0 +1,335 @@
+#include "engine/maze/MazeBitboard.h"
+#include "engine/core/Cpu.h"
+#include "engine/maze/Maze.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(MAZE3D_AVX2_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+uint64_t lastWordMask(int width)
+{
+    return (width & 63) ? (1ull << (width & 63)) - 1 : ~0ull;
+}
+
+// Occluded fills: spread g through runs of `open` bits in log2(64) steps.
+// Bit i of `open` means cell i can be entered from its neighbour below
+// (fillUp) or above (fillDown) in bit order.
+uint64_t fillUp(uint64_t g, uint64_t open)
+{
+    g |= open & (g << 1);  open &= open << 1;
+    g |= open & (g << 2);  open &= open << 2;
+    g |= open & (g << 4);  open &= open << 4;
+    g |= open & (g << 8);  open &= open << 8;
+    g |= open & (g << 16); open &= open << 16;
+    g |= open & (g << 32);
+    return g;
+}
+
+uint64_t fillDown(uint64_t g, uint64_t open)
+{
+    g |= open & (g >> 1);  open &= open >> 1;
+    g |= open & (g >> 2);  open &= open >> 2;
+    g |= open & (g >> 4);  open &= open >> 4;
+    g |= open & (g >> 8);  open &= open >> 8;
+    g |= open & (g >> 16); open &= open >> 16;
+    g |= open & (g >> 32);
+    return g;
+}
+
+// Bits set in exactly three of the four masks
+uint64_t exactlyThree(uint64_t a, uint64_t b, uint64_t c, uint64_t d)
+{
+    return ((a & b) & (c ^ d)) | ((a ^ b) & (c & d));
+}
+
+size_t popcountScalar(const uint64_t* words, int count)
+{
+    size_t total = 0;
+    for (int i = 0; i < count; ++i)
+        total += std::popcount(words[i]);
+    return total;
+}
+
+#if defined(MAZE3D_AVX2_KERNELS)
+// Per-lane popcount via nibble lookup; returns four 64-bit sums
+MAZE3D_AVX2_TARGET __m256i popcount256(__m256i v)
+{
+    const __m256i lut = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+MAZE3D_AVX2_TARGET size_t horizontalSum(__m256i v)
+{
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+MAZE3D_AVX2_TARGET size_t popcountAvx2(const uint64_t* words, int count)
+{
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        acc = _mm256_add_epi64(acc, popcount256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))));
+    return horizontalSum(acc) + popcountScalar(words + i, count - i);
+}
+
+// Dead ends among the cells of words [0, w) of a row, four words at a
+// time; w is advanced past the words counted. The East wall of a word's
+// top bit is bit 0 of the next word, so the loop stops short of the row's
+// last word.
+MAZE3D_AVX2_TARGET size_t deadEndsAvx2(
+    const uint64_t* north, const uint64_t* south, const uint64_t* west, int wpr, int& w)
+{
+    __m256i acc = _mm256_setzero_si256();
+    for (; w + 4 < wpr; w += 4) {
+        __m256i n  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(north + w));
+        __m256i s  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(south + w));
+        __m256i wv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(west + w));
+        __m256i wn = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(west + w + 1));
+        __m256i e  = _mm256_or_si256(_mm256_srli_epi64(wv, 1), _mm256_slli_epi64(wn, 63));
+
+        __m256i ns = _mm256_and_si256(n, s), nx = _mm256_xor_si256(n, s);
+        __m256i we = _mm256_and_si256(wv, e), wx = _mm256_xor_si256(wv, e);
+        __m256i three = _mm256_or_si256(_mm256_and_si256(ns, wx), _mm256_and_si256(nx, we));
+        acc = _mm256_add_epi64(acc, popcount256(three));
+    }
+    return horizontalSum(acc);
+}
+#endif
+
+size_t popcountWords(const uint64_t* words, int count)
+{
+#if defined(MAZE3D_AVX2_KERNELS)
+    if (cpuHasAvx2())
+        return popcountAvx2(words, count);
+#endif
+    return popcountScalar(words, count);
+}
+
+} // namespace
+
+// --- MazeBitset ---
+
+void MazeBitset::resize(int width, int height)
+{
+    m_width = width;
+    m_height = height;
+    m_wordsPerRow = (width + 63) / 64;
+    m_words.assign(static_cast<size_t>(height) * m_wordsPerRow, 0);
+}
+
+void MazeBitset::clear()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+size_t MazeBitset::count() const
+{
+    return popcountWords(m_words.data(), static_cast<int>(m_words.size()));
+}
+
+// --- Flood fill ---
+
+size_t MazeBitboard::fill(const Maze& maze, int x, int y)
+{
+    const int wpr = maze.wordsPerRow();
+    const int h = maze.height();
+    const uint64_t lastMask = lastWordMask(maze.width());
+    uint64_t* reached = m_reached.row(0);
+    size_t added = 0;
+
+    auto seed = [&](int row, int word, uint64_t bits) {
+        size_t i = static_cast<size_t>(row) * wpr + word;
+        bits &= ~reached[i];
+        if (bits) {
+            reached[i] |= bits;
+            added += std::popcount(bits);
+            m_work.push_back(static_cast<uint32_t>(i));
+        }
+    };
+
+    m_work.clear();
+    seed(y, x >> 6, 1ull << (x & 63));
+
+    while (!m_work.empty()) {
+        uint32_t i = m_work.back();
+        m_work.pop_back();
+        int row = static_cast<int>(i / wpr);
+        int word = static_cast<int>(i % wpr);
+
+        const uint64_t* west = maze.westRow(row);
+        uint64_t valid = (word == wpr - 1) ? lastMask : ~0ull;
+
+        // Spread along the row inside this word. Bit 0 and bit 63 are
+        // entered from the neighbouring words, handled below.
+        uint64_t right = ~west[word] & valid & ~1ull;
+        uint64_t left  = ~(west[word] >> 1) & (valid >> 1);
+        uint64_t g = reached[i];
+        g = fillUp(g, right) | fillDown(g, left);
+        added += std::popcount(g & ~reached[i]);
+        reached[i] = g;
+
+        if ((g >> 63) && word + 1 < wpr && !(west[word + 1] & 1u))
+            seed(row, word + 1, 1ull);
+        if ((g & 1u) && word > 0 && !(west[word] & 1u))
+            seed(row, word - 1, 1ull << 63);
+
+        // Vertical moves cross a row's North walls
+        if (row > 0)
+            seed(row - 1, word, g & ~maze.northRow(row)[word]);
+        if (row + 1 < h)
+            seed(row + 1, word, g & ~maze.northRow(row + 1)[word]);
+    }
+
+    return added;
+}
+
+const MazeBitset& MazeBitboard::floodFill(const Maze& maze, int x, int y)
+{
+    m_reached.resize(maze.width(), maze.height());
+    if (x >= 0 && y >= 0 && x < maze.width() && y < maze.height())
+        fill(maze, x, y);
+    return m_reached;
+}
+
+const std::vector<MazeBitboard::Region>& MazeBitboard::findRegions(const Maze& maze)
+{
+    const int wpr = maze.wordsPerRow();
+    const uint64_t lastMask = lastWordMask(maze.width());
+
+    m_reached.resize(maze.width(), maze.height());
+    m_regions.clear();
+
+    for (int y = 0; y < maze.height(); ++y) {
+        uint64_t* reached = m_reached.row(y);
+        for (int w = 0; w < wpr; ++w) {
+            uint64_t valid = (w == wpr - 1) ? lastMask : ~0ull;
+            uint64_t open = ~reached[w] & valid;
+            while (open) {
+                int x = w * 64 + std::countr_zero(open);
+                m_regions.push_back({ x, y, fill(maze, x, y) });
+                open = ~reached[w] & valid;
+            }
+        }
+    }
+
+    std::stable_sort(m_regions.begin(), m_regions.end(),
+        [](const Region& a, const Region& b) { return a.cells > b.cells; });
+    return m_regions;
+}
+
+// --- Wall statistics ---
+
+size_t MazeBitboard::countDeadEnds(const Maze& maze) const
+{
+    const int wpr = maze.wordsPerRow();
+    const int h = maze.height();
+    const int lastBit = (maze.width() - 1) & 63;
+    size_t total = 0;
+#if defined(MAZE3D_AVX2_KERNELS)
+    const bool avx2 = cpuHasAvx2();
+#endif
+
+    for (int y = 0; y < h; ++y) {
+        const uint64_t* north = maze.northRow(y);
+        const uint64_t* south = (y + 1 < h) ? maze.northRow(y + 1) : maze.southBorderRow();
+        const uint64_t* west = maze.westRow(y);
+        int w = 0;
+
+#if defined(MAZE3D_AVX2_KERNELS)
+        if (avx2)
+            total += deadEndsAvx2(north, south, west, wpr, w);
+#endif
+
+        for (; w < wpr; ++w) {
+            uint64_t e = west[w] >> 1;
+            if (w + 1 < wpr)
+                e |= west[w + 1] << 63;
+            else if (maze.eastBorder(y))
+                e |= 1ull << lastBit;
+            total += std::popcount(exactlyThree(north[w], south[w], west[w], e));
+        }
+    }
+    return total;
+}
+
+void MazeBitboard::rowWallDensity(const Maze& maze, std::vector<float>& out) const
+{
+    const int wpr = maze.wordsPerRow();
+    const float slots = 2.0f * maze.width();
+
+    out.resize(maze.height());
+    for (int y = 0; y < maze.height(); ++y) {
+        size_t walls = popcountWords(maze.northRow(y), wpr) + popcountWords(maze.westRow(y), wpr);
+        out[y] = walls / slots;
+    }
+}
+
+void MazeBitboard::columnWallDensity(const Maze& maze, std::vector<float>& out)
+{
+    // Per-column counts are kept bit-sliced: plane k holds bit k of every
+    // column's count, so adding a row is a word-wide ripple-carry add.
+    // Eight planes hold up to 255, so they are flushed every 127 rows.
+    constexpr int PLANES = 8;
+    constexpr int FLUSH_ROWS = 127;
+
+    const int wpr = maze.wordsPerRow();
+    const int width = maze.width();
+
+    m_counters.assign(static_cast<size_t>(PLANES) * wpr, 0);
+    m_columnCounts.assign(width, 0);
+
+    auto add = [&](int w, uint64_t carry) {
+        for (int k = 0; k < PLANES && carry; ++k) {
+            uint64_t& plane = m_counters[static_cast<size_t>(k) * wpr + w];
+            uint64_t next = plane & carry;
+            plane ^= carry;
+            carry = next;
+        }
+    };
+
+    auto flush = [&]() {
+        for (int k = 0; k < PLANES; ++k) {
+            for (int w = 0; w < wpr; ++w) {
+                uint64_t& plane = m_counters[static_cast<size_t>(k) * wpr + w];
+                for (uint64_t bits = plane; bits; bits &= bits - 1)
+                    m_columnCounts[w * 64 + std::countr_zero(bits)] += 1u << k;
+                plane = 0;
+            }
+        }
+    };
+
+    for (int y = 0; y < maze.height(); ++y) {
+        const uint64_t* north = maze.northRow(y);
+        const uint64_t* west = maze.westRow(y);
+        for (int w = 0; w < wpr; ++w) {
+            add(w, north[w]);
+            add(w, west[w]);
+        }
+        if ((y + 1) % FLUSH_ROWS == 0)
+            flush();
+    }
+    flush();
+
+    const float slots = 2.0f * maze.height();
+    out.resize(width);
+    for (int x = 0; x < width; ++x)
+        out[x] = m_columnCounts[x] / slots;
+}
+
+} // namespace engine
@@ -1,65 +1,408 @@
 #include "engine/maze/MazeCollider.h"
+#include "engine/core/Cpu.h"
 #include "engine/maze/Maze.h"
 #include "engine/maze/MazeTypes.h"
+#include "engine/maze/MazeWallRuns.h"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#if defined(MAZE3D_X86_64)
+#include <immintrin.h>
+#endif
 
 namespace engine {
 
-void MazeCollider::build(const Maze& maze)
+namespace {
+
+constexpr float CELL = 1.0f;
+constexpr float WALL_HEIGHT = 1.0f;
+constexpr float WALL_THICKNESS = 0.1f;
+
+// Slots read past the last cell by up to one SIMD width
+constexpr size_t SIMD_PAD = 8;
+
+// Slot order within a cell, also the order boxes are tested in
+enum Slot { SLOT_NORTH, SLOT_SOUTH, SLOT_WEST, SLOT_EAST };
+
+int slotOf(Direction dir)
 {
-    constexpr float CELL = 1.0f;
-    constexpr float WALL_HEIGHT = 1.0f;
-    constexpr float WALL_THICKNESS = 0.1f;
+    switch (dir) {
+        case North: return SLOT_NORTH;
+        case South: return SLOT_SOUTH;
+        case West:  return SLOT_WEST;
+        default:    return SLOT_EAST;
+    }
+}
+
+// Box on `slot`'s side of a whole run; (ox, oz) is the world corner of
+// cell (0, 0)
+MazeCollider::AABB runBox(const WallRun& run, int slot, float ox, float oz)
+{
+    const float line = run.line * CELL;
+    const float begin = run.begin * CELL;
+    const float end = run.end * CELL;
+
+    switch (slot) {
+        case SLOT_NORTH:
+            return { { ox + begin, 0, oz + line - WALL_THICKNESS },
+                     { ox + end, WALL_HEIGHT, oz + line } };
+        case SLOT_SOUTH:
+            return { { ox + begin, 0, oz + line },
+                     { ox + end, WALL_HEIGHT, oz + line + WALL_THICKNESS } };
+        case SLOT_WEST:
+            return { { ox + line - WALL_THICKNESS, 0, oz + begin },
+                     { ox + line, WALL_HEIGHT, oz + end } };
+        default:
+            return { { ox + line, 0, oz + begin },
+                     { ox + line + WALL_THICKNESS, WALL_HEIGHT, oz + end } };
+    }
+}
 
-    m_walls.clear();
+constexpr float INF = std::numeric_limits<float>::infinity();
 
-    for (int y = 0; y < maze.height(); ++y) {
-        for (int x = 0; x < maze.width(); ++x) {
-            const auto& cell = maze.cell(x, y);
+// Gap a sweep leaves between the sphere and the wall it stops at
+constexpr float SKIN = 1e-4f;
 
-            float fx = x * CELL;
-            float fz = y * CELL;
+} // namespace
 
-            auto addWall = [&](glm::vec3 min, glm::vec3 max) {
-                m_walls.push_back({ min, max });
-            };
+void MazeCollider::build(const Maze& maze, int originX, int originY)
+{
+    m_width = maze.width();
+    m_height = maze.height();
+    m_originX = originX;
+    m_originY = originY;
 
-            if (cell.walls & North)
-                addWall(
-                    { fx, 0, fz - WALL_THICKNESS },
-                    { fx + CELL, WALL_HEIGHT, fz }
-                );
+    const size_t slots = static_cast<size_t>(m_width) * m_height * 4 + SIMD_PAD;
+    m_minX.assign(slots, INF);
+    m_maxX.assign(slots, -INF);
+    m_minZ.assign(slots, INF);
+    m_maxZ.assign(slots, -INF);
+    m_wallCount = 0;
 
-            if (cell.walls & South)
-                addWall(
-                    { fx, 0, fz + CELL },
-                    { fx + CELL, WALL_HEIGHT, fz + CELL + WALL_THICKNESS }
-                );
+    forEachWallRun(maze, [this](const WallRun& run) { writeRun(run, true); });
+
+    if (m_backend == Backend::DistanceField)
+        m_field.build(maze, m_field.samplesPerCell(), originX, originY);
+}
 
-            if (cell.walls & West)
-                addWall(
-                    { fx - WALL_THICKNESS, 0, fz },
-                    { fx, WALL_HEIGHT, fz + CELL }
-                );
+void MazeCollider::editWall(const Maze& maze, const WallEdit& edit)
+{
+    if (m_minX.empty()) return;
 
-            if (cell.walls & East)
-                addWall(
-                    { fx + CELL, 0, fz },
-                    { fx + CELL + WALL_THICKNESS, WALL_HEIGHT, fz + CELL }
-                );
+    // Nothing to do if the wall's slot already matches; otherwise the
+    // runs through it were joined or split
+    const bool inside = edit.x >= 0 && edit.y >= 0 && edit.x < m_width && edit.y < m_height;
+    const size_t slot = inside ? cellIndex(edit.x, edit.y) * 4 + slotOf(edit.dir) : 0;
+    if (inside && maze.hasWall(edit.x, edit.y, edit.dir) != hasSlot(slot)) {
+        const WallRunEdit change = wallRunEdit(maze, edit);
+        for (const WallRun& run : change.before) {
+            if (!run.empty()) writeRun(run, false);
+        }
+        for (const WallRun& run : change.after) {
+            if (!run.empty()) writeRun(run, true);
         }
     }
+
+    if (m_backend == Backend::DistanceField)
+        m_field.editWall(maze, edit);
 }
 
-bool MazeCollider::sphereIntersectsAABB(
-    const glm::vec3& c,
-    float r,
-    const AABB& b
-) const {
-    float x = std::max(b.min.x, std::min(c.x, b.max.x));
-    float y = std::max(b.min.y, std::min(c.y, b.max.y));
-    float z = std::max(b.min.z, std::min(c.z, b.max.z));
+void MazeCollider::setBackend(Backend backend, const Maze& maze, int samplesPerCell)
+{
+    m_backend = backend;
+    if (backend == Backend::DistanceField)
+        m_field.build(maze, samplesPerCell, m_originX, m_originY);
+    else
+        m_field = MazeDistanceField{};
+}
+
+const char* MazeCollider::backendName(Backend backend)
+{
+    switch (backend) {
+        case Backend::Boxes:         return "Boxes";
+        case Backend::DistanceField: return "Distance Field";
+    }
+    return "Unknown";
+}
+
+void MazeCollider::writeRun(const WallRun& run, bool set)
+{
+    const int lines = run.horizontal ? m_height : m_width;
+
+    // Side 0 is the cells after the line (their N or W slot), side 1 the
+    // cells before it (S or E); the border lines have only one
+    for (int side = 0; side < 2; ++side) {
+        const int cellLine = run.line - side;
+        if (cellLine < 0 || cellLine >= lines) continue;
+
+        const int s = run.horizontal ? (side == 0 ? SLOT_NORTH : SLOT_SOUTH)
+                                     : (side == 0 ? SLOT_WEST : SLOT_EAST);
+        const AABB box = runBox(run, s, m_originX * CELL, m_originY * CELL);
+
+        for (int at = run.begin; at < run.end; ++at) {
+            const size_t cell = run.horizontal ? cellIndex(at, cellLine) : cellIndex(cellLine, at);
+            if (set) setSlot(cell * 4 + s, box);
+            else     clearSlot(cell * 4 + s);
+        }
+
+        if (set) ++m_wallCount;
+        else     --m_wallCount;
+    }
+}
+
+void MazeCollider::setSlot(size_t slot, const AABB& box)
+{
+    m_minX[slot] = box.min.x;
+    m_maxX[slot] = box.max.x;
+    m_minZ[slot] = box.min.z;
+    m_maxZ[slot] = box.max.z;
+}
+
+void MazeCollider::clearSlot(size_t slot)
+{
+    m_minX[slot] = INF;
+    m_maxX[slot] = -INF;
+    m_minZ[slot] = INF;
+    m_maxZ[slot] = -INF;
+}
+
+std::vector<MazeCollider::AABB> MazeCollider::walls() const
+{
+    std::vector<AABB> boxes;
+    boxes.reserve(m_wallCount);
+
+    // A run's box is in every cell along it; take it from the first
+    for (size_t slot = 0; slot + SIMD_PAD < m_minX.size(); ++slot) {
+        if (!hasSlot(slot)) continue;
+
+        const size_t cell = slot / 4;
+        const bool horizontal = (slot & 3) == SLOT_NORTH || (slot & 3) == SLOT_SOUTH;
+        const bool first = horizontal
+            ? m_minX[slot] == (m_originX + static_cast<int>(cell % m_width)) * CELL
+            : m_minZ[slot] == (m_originY + static_cast<int>(cell / m_width)) * CELL;
+        if (first)
+            boxes.push_back({ { m_minX[slot], 0, m_minZ[slot] },
+                              { m_maxX[slot], WALL_HEIGHT, m_maxZ[slot] } });
+    }
+    return boxes;
+}
+
+// --- Continuous collision ---
+
+bool MazeCollider::sweepSlot(size_t slot, const glm::vec2& p, const glm::vec2& d, float r,
+                             float& time, glm::vec2& normal) const
+{
+    if (!hasSlot(slot)) return false;
+
+    const glm::vec2 lo(m_minX[slot], m_minZ[slot]);
+    const glm::vec2 hi(m_maxX[slot], m_maxZ[slot]);
+
+    // Most boxes in the neighbourhood are nowhere near the motion
+    const glm::vec2 end = p + d;
+    if (std::max(p.x, end.x) + r < lo.x || std::min(p.x, end.x) - r > hi.x ||
+        std::max(p.y, end.y) + r < lo.y || std::min(p.y, end.y) - r > hi.y)
+        return false;
+
+    // Already touching: a contact at t = 0 unless moving away. Within SKIN
+    // counts, as that is where sweeps and resolve() leave a sphere, and the
+    // slab test below can round such a start to no contact at all.
+    const glm::vec2 closest = glm::clamp(p, lo, hi);
+    const glm::vec2 away = p - closest;
+    const float dist2 = glm::dot(away, away);
+    const float touch = r + SKIN;
+    if (dist2 < touch * touch) {
+        if (dist2 == 0.0f || glm::dot(away, d) >= 0.0f)
+            return false;   // centre inside the box is resolve()'s job
+        time = 0.0f;
+        normal = away / std::sqrt(dist2);
+        return true;
+    }
+
+    // Slab test against the box grown by r
+    float tEnter = 0.0f, tExit = 1.0f;
+    int axis = -1;
+    for (int a = 0; a < 2; ++a) {
+        if (d[a] == 0.0f) {
+            if (p[a] < lo[a] - r || p[a] > hi[a] + r) return false;
+            continue;
+        }
+        float t0 = (lo[a] - r - p[a]) / d[a];
+        float t1 = (hi[a] + r - p[a]) / d[a];
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > tEnter) { tEnter = t0; axis = a; }
+        tExit = std::min(tExit, t1);
+        if (tEnter > tExit) return false;
+    }
+
+    // Entered through a face: that is the contact. No entering axis means
+    // the start is already inside the grown box, in a corner square.
+    const glm::vec2 q = p + d * tEnter;
+    const int other = axis ^ 1;
+    if (axis >= 0 && q[other] >= lo[other] && q[other] <= hi[other]) {
+        time = tEnter;
+        normal = glm::vec2(0.0f);
+        normal[axis] = d[axis] > 0.0f ? -1.0f : 1.0f;
+        return true;
+    }
+
+    // Entered through a corner square: the rounded corner is a circle of
+    // radius r around the box corner, and the only part it can touch there
+    const glm::vec2 corner(q.x < lo.x ? lo.x : hi.x, q.y < lo.y ? lo.y : hi.y);
+    const glm::vec2 m = p - corner;
+    const float a = glm::dot(d, d);
+    const float b = glm::dot(m, d);
+    const float c = glm::dot(m, m) - r * r;
+    const float disc = b * b - a * c;
+    if (disc < 0.0f) return false;
+
+    const float t = (-b - std::sqrt(disc)) / a;
+    if (t < 0.0f || t > 1.0f) return false;
+
+    time = t;
+    normal = glm::normalize(p + d * t - corner);
+    return true;
+}
+
+MazeCollider::SweepHit MazeCollider::sweep(const glm::vec3& start, const glm::vec3& delta, float radius) const
+{
+    SweepHit result;
+    result.position = start + delta;
+    if (m_minX.empty()) return result;
+
+    // Walls are vertical, so height only narrows the circle the sphere cuts
+    const float dy = std::max(0.0f, std::min(start.y, WALL_HEIGHT)) - start.y;
+    if (dy * dy >= radius * radius) return result;
+    const float r = std::sqrt(radius * radius - dy * dy);
+
+    const glm::vec2 p(start.x, start.z);
+    const glm::vec2 d(delta.x, delta.z);
+
+    // Neighbourhood around the centre's cell holding every box within reach
+    const int k = static_cast<int>(std::ceil((r + 2.0f * WALL_THICKNESS) / CELL));
+
+    float best = 2.0f;
+    glm::vec2 bestNormal(0.0f);
+
+    auto testCell = [&](int cx, int cy) {
+        const int x = cx - m_originX;
+        const int y = cy - m_originY;
+        if (x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+
+        for (size_t slot = cellIndex(x, y) * 4, end = slot + 4; slot < end; ++slot) {
+            float t;
+            glm::vec2 n;
+            if (sweepSlot(slot, p, d, r, t, n) && t < best) {
+                best = t;
+                bestNormal = n;
+            }
+        }
+    };
+
+    // --- Amanatides-Woo walk of the centre's cells ---
+    int cx = static_cast<int>(std::floor(p.x / CELL));
+    int cy = static_cast<int>(std::floor(p.y / CELL));
+    const int endX = static_cast<int>(std::floor((p.x + d.x) / CELL));
+    const int endY = static_cast<int>(std::floor((p.y + d.y) / CELL));
+
+    const int stepX = d.x > 0.0f ? 1 : -1;
+    const int stepY = d.y > 0.0f ? 1 : -1;
+    const float deltaX = d.x != 0.0f ? std::abs(CELL / d.x) : INF;
+    const float deltaY = d.y != 0.0f ? std::abs(CELL / d.y) : INF;
+    float nextX = d.x != 0.0f ? ((stepX > 0 ? (cx + 1) * CELL : cx * CELL) - p.x) / d.x : INF;
+    float nextY = d.y != 0.0f ? ((stepY > 0 ? (cy + 1) * CELL : cy * CELL) - p.y) / d.y : INF;
+
+    for (int oy = -k; oy <= k; ++oy)
+        for (int ox = -k; ox <= k; ++ox)
+            testCell(cx + ox, cy + oy);
+
+    // Each step brings one new row or column of the neighbourhood into
+    // reach. Its boxes are at least a cell away from the boundary just
+    // crossed, so none can be hit before that crossing time.
+    while (cx != endX || cy != endY) {
+        float crossing;
+        if (nextX < nextY) {
+            crossing = nextX;
+            if (crossing > 1.0f || best <= crossing) break;
+            cx += stepX;
+            nextX += deltaX;
+            for (int o = -k; o <= k; ++o) testCell(cx + stepX * k, cy + o);
+        }
+        else {
+            crossing = nextY;
+            if (crossing > 1.0f || best <= crossing) break;
+            cy += stepY;
+            nextY += deltaY;
+            for (int o = -k; o <= k; ++o) testCell(cx + o, cy + stepY * k);
+        }
+    }
+
+    if (best > 1.0f) return result;
+
+    // Stop a hair short of contact, and off the wall
+    const float length = glm::length(d);
+    const float t = length > 0.0f ? std::max(0.0f, best - SKIN / length) : 0.0f;
+
+    const glm::vec3 normal(bestNormal.x, 0.0f, bestNormal.y);
+    const glm::vec3 rest = delta * (1.0f - best);
+
+    result.hit = true;
+    result.time = best;
+    result.position = start + delta * t + normal * SKIN;
+    result.normal = normal;
+    result.slide = rest - normal * glm::dot(rest, normal);
+    return result;
+}
+
+glm::vec3 MazeCollider::moveAndSlide(const glm::vec3& start, const glm::vec3& delta, float radius,
+                                     int maxSlides) const
+{
+    return slide(start, delta, maxSlides, [this, radius](const glm::vec3& pos, const glm::vec3& motion) {
+        return sweep(pos, motion, radius);
+    });
+}
+
+glm::vec3 MazeCollider::slide(const glm::vec3& start, const glm::vec3& delta, int maxSlides,
+                              const SweepFn& sweep)
+{
+    glm::vec3 pos = start;
+    glm::vec3 motion = delta;
+
+    for (int i = 0; i <= maxSlides; ++i) {
+        SweepHit hit = sweep(pos, motion);
+        pos = hit.position;
+        if (!hit.hit || i == maxSlides) break;
+
+        motion = hit.slide;
+        if (glm::dot(motion, motion) < 1e-12f) break;
+    }
+    return pos;
+}
+
+// --- Queries ---
+
+bool MazeCollider::window(const glm::vec3& pos, float radius, int& x0, int& y0, int& x1, int& y1) const
+{
+    if (m_minX.empty()) return false;
+
+    // Boxes stick out of their cell by one wall thickness, plus slack so
+    // rounding at a cell edge never drops a box the sphere just touches
+    const float reach = radius + WALL_THICKNESS + 0.01f;
+    x0 = std::max(static_cast<int>(std::floor((pos.x - reach) / CELL)) - m_originX, 0);
+    x1 = std::min(static_cast<int>(std::floor((pos.x + reach) / CELL)) - m_originX, m_width - 1);
+    y0 = std::max(static_cast<int>(std::floor((pos.z - reach) / CELL)) - m_originY, 0);
+    y1 = std::min(static_cast<int>(std::floor((pos.z + reach) / CELL)) - m_originY, m_height - 1);
+    return x0 <= x1 && y0 <= y1;
+}
+
+bool MazeCollider::touches(size_t slot, const glm::vec3& c, float r) const
+{
+    float x = std::max(m_minX[slot], std::min(c.x, m_maxX[slot]));
+    float y = std::max(0.0f, std::min(c.y, WALL_HEIGHT));
+    float z = std::max(m_minZ[slot], std::min(c.z, m_maxZ[slot]));
 
     float dx = c.x - x;
     float dy = c.y - y;
@@ -68,27 +411,196 @@ bool MazeCollider::sphereIntersectsAABB(
     return (dx*dx + dy*dy + dz*dz) < (r * r);
 }
 
+bool MazeCollider::repeated(size_t slot, int x, int y, int x0, int y0) const
+{
+    // A run's box continues into the previous cell along it, whose slot
+    // holds the same box and was tested first when it is in the window
+    const int side = static_cast<int>(slot & 3);
+    if (side == SLOT_NORTH || side == SLOT_SOUTH)
+        return x > x0 && m_minX[slot] < (m_originX + x) * CELL;
+    return y > y0 && m_minZ[slot] < (m_originY + y) * CELL;
+}
+
+void MazeCollider::pushOut(size_t slot, glm::vec3& pos, float radius) const
+{
+    // push out along smallest axis
+    float left   = pos.x - m_minX[slot];
+    float right  = m_maxX[slot] - pos.x;
+    float front  = pos.z - m_minZ[slot];
+    float back   = m_maxZ[slot] - pos.z;
+
+    float minPen = std::min({ left, right, front, back });
+
+    if (minPen == left)  pos.x = m_minX[slot] - radius;
+    if (minPen == right) pos.x = m_maxX[slot] + radius;
+    if (minPen == front) pos.z = m_minZ[slot] - radius;
+    if (minPen == back)  pos.z = m_maxZ[slot] + radius;
+}
+
+void MazeCollider::resolveScalar(glm::vec3& pos, float radius) const
+{
+    int x0, y0, x1, y1;
+    if (!window(pos, radius, x0, y0, x1, y1)) return;
+
+    // Row-major, N/S/W/E within a cell; each box once
+    for (int y = y0; y <= y1; ++y) {
+        const size_t begin = cellIndex(x0, y) * 4;
+        const size_t end = cellIndex(x1, y) * 4 + 4;
+        for (size_t slot = begin; slot < end; ++slot) {
+            const int x = x0 + static_cast<int>((slot - begin) / 4);
+            if (touches(slot, pos, radius) && !repeated(slot, x, y, x0, y0))
+                pushOut(slot, pos, radius);
+        }
+    }
+}
+
+#if defined(MAZE3D_AVX2_KERNELS)
+namespace {
+
+// Bit i set when slot + i may touch the sphere. The radius is padded a
+// little, so it never clears a bit the scalar test would set.
+// Only these two functions are AVX2: each leaves the upper halves clear
+// on return, so the scalar box tests between them run without SSE/AVX
+// transition stalls.
+struct Prefilter {
+    __m256 cx, cz, dy2, r2;
+
+    MAZE3D_AVX2_TARGET void reset(const glm::vec3& pos, float radius)
+    {
+        const float slack = radius + 1e-4f;
+        const float dy = std::max(0.0f, std::min(pos.y, WALL_HEIGHT)) - pos.y;
+        cx = _mm256_set1_ps(pos.x);
+        cz = _mm256_set1_ps(pos.z);
+        dy2 = _mm256_set1_ps(dy * dy);
+        r2 = _mm256_set1_ps(slack * slack);
+    }
+
+    MAZE3D_AVX2_TARGET unsigned test(const float* minX, const float* maxX,
+                                     const float* minZ, const float* maxZ) const
+    {
+        __m256 qx = _mm256_max_ps(_mm256_loadu_ps(minX), _mm256_min_ps(cx, _mm256_loadu_ps(maxX)));
+        __m256 qz = _mm256_max_ps(_mm256_loadu_ps(minZ), _mm256_min_ps(cz, _mm256_loadu_ps(maxZ)));
+        __m256 dx = _mm256_sub_ps(cx, qx);
+        __m256 dz = _mm256_sub_ps(cz, qz);
+        __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dz, dz)), dy2);
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LT_OQ)));
+    }
+};
+
+} // namespace
+
+void MazeCollider::resolveAvx2(glm::vec3& pos, float radius) const
+{
+    int x0, y0, x1, y1;
+    if (!window(pos, radius, x0, y0, x1, y1)) return;
+
+    // Eight slots per test; only candidates reach the scalar test, still in
+    // slot order. A push moves the sphere, so the filter is redone from
+    // the new position for the slots after it.
+    Prefilter filter;
+    filter.reset(pos, radius);
+
+    for (int y = y0; y <= y1; ++y) {
+        const size_t begin = cellIndex(x0, y) * 4;
+        const size_t end = cellIndex(x1, y) * 4 + 4;
+
+        for (size_t slot = begin; slot < end; slot += 8) {
+            const unsigned valid = end - slot >= 8 ? 0xffu : (1u << (end - slot)) - 1;
+            unsigned mask = filter.test(&m_minX[slot], &m_maxX[slot], &m_minZ[slot], &m_maxZ[slot]) & valid;
+
+            while (mask) {
+                const unsigned lane = static_cast<unsigned>(std::countr_zero(mask));
+                mask &= mask - 1;
+                const int x = x0 + static_cast<int>((slot + lane - begin) / 4);
+                if (!touches(slot + lane, pos, radius) || repeated(slot + lane, x, y, x0, y0)) continue;
+
+                pushOut(slot + lane, pos, radius);
+                filter.reset(pos, radius);
+                mask = filter.test(&m_minX[slot], &m_maxX[slot], &m_minZ[slot], &m_maxZ[slot])
+                     & valid & ~((2u << lane) - 1);
+            }
+        }
+    }
+}
+#endif
+
 // Resolve collisions (slide-friendly)
 void MazeCollider::resolve(glm::vec3& pos, float radius) const
 {
-    for (const auto& wall : m_walls) {
-        if (!sphereIntersectsAABB(pos, radius, wall))
-            continue;
+    if (m_backend == Backend::DistanceField) {
+        m_field.resolve(pos, radius);
+        return;
+    }
+
+#if defined(MAZE3D_AVX2_KERNELS)
+    // Picked once, from what the running CPU supports
+    using Resolve = void (MazeCollider::*)(glm::vec3&, float) const;
+    static const Resolve boxes = cpuHasAvx2() ? &MazeCollider::resolveAvx2 : &MazeCollider::resolveScalar;
+    (this->*boxes)(pos, radius);
+#else
+    resolveScalar(pos, radius);
+#endif
+}
 
-        // push out along smallest axis
-        float left   = pos.x - wall.min.x;
-        float right  = wall.max.x - pos.x;
-        float front  = pos.z - wall.min.z;
-        float back   = wall.max.z - pos.z;
+void MazeCollider::prefetch(const glm::vec3& pos, float radius) const
+{
+#if defined(MAZE3D_X86_64)
+    int x0, y0, x1, y1;
+    if (!window(pos, radius, x0, y0, x1, y1)) return;
+
+    for (int y = y0; y <= y1; ++y) {
+        const size_t first = cellIndex(x0, y) * 4;
+        const size_t last = cellIndex(x1, y) * 4 + 3;
+        for (const std::vector<float>* plane : { &m_minX, &m_maxX, &m_minZ, &m_maxZ }) {
+            _mm_prefetch(reinterpret_cast<const char*>(&(*plane)[first]), _MM_HINT_T0);
+            _mm_prefetch(reinterpret_cast<const char*>(&(*plane)[last]), _MM_HINT_T0);
+        }
+    }
+#else
+    (void)pos;
+    (void)radius;
+#endif
+}
 
-        float minPen = std::min({ left, right, front, back });
+void MazeCollider::resolve(std::span<glm::vec3> positions, std::span<const float> radii) const
+{
+    // Agents are usually scattered over the maze; fetching a few ahead
+    // overlaps their cache misses with the current agent's tests
+    constexpr size_t AHEAD = 8;
+
+    if (m_backend == Backend::DistanceField) {
+        m_field.resolve(positions, radii);
+        return;
+    }
 
-        if (minPen == left)  pos.x = wall.min.x - radius;
-        if (minPen == right) pos.x = wall.max.x + radius;
-        if (minPen == front) pos.z = wall.min.z - radius;
-        if (minPen == back)  pos.z = wall.max.z + radius;
+    const size_t count = std::min(positions.size(), radii.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (i + AHEAD < count)
+            prefetch(positions[i + AHEAD], radii[i + AHEAD]);
+        resolve(positions[i], radii[i]);
     }
 }
 
-} // namespace engine
+void MazeCollider::resolve(std::span<glm::vec3> positions, float radius) const
+{
+    constexpr size_t AHEAD = 8;
 
+    if (m_backend == Backend::DistanceField) {
+        m_field.resolve(positions, radius);
+        return;
+    }
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        if (i + AHEAD < positions.size())
+            prefetch(positions[i + AHEAD], radius);
+        resolve(positions[i], radius);
+    }
+}
+
+size_t MazeCollider::memoryBytes() const
+{
+    return (m_minX.capacity() + m_maxX.capacity() + m_minZ.capacity() + m_maxZ.capacity()) * sizeof(float)
+         + m_field.memoryBytes();
+}
+
+} // namespace engine
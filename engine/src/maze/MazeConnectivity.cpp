@@ -0,0 +1,383 @@
+#include "engine/maze/MazeConnectivity.h"
+#include "engine/maze/Maze.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+// Cells the halves may grow by per loop edge before scanning the loop
+// edges is cheaper; one scan step is two root queries
+constexpr size_t CELLS_PER_LOOP = 16;
+
+} // namespace
+
+const char* MazeConnectivity::statusName(Status status)
+{
+    switch (status) {
+        case Status::Perfect:      return "perfect";
+        case Status::HasLoops:     return "has loops";
+        case Status::Disconnected: return "disconnected";
+    }
+    return "unknown";
+}
+
+const char* MazeConnectivity::effectName(Effect effect)
+{
+    switch (effect) {
+        case Effect::Unchanged:      return "unchanged";
+        case Effect::RegionsJoined:  return "regions joined";
+        case Effect::LoopIntroduced: return "loop introduced";
+        case Effect::LoopBroken:     return "loop broken";
+        case Effect::RegionIsolated: return "region isolated";
+    }
+    return "unknown";
+}
+
+void MazeConnectivity::build(const Maze& maze)
+{
+    m_width = maze.width();
+    m_cells = static_cast<size_t>(maze.width()) * maze.height();
+    m_treeEdges = 0;
+
+    m_child.assign(m_cells * 2, NONE);
+    m_up.assign(m_cells, NONE);
+    m_flip.assign(m_cells, 0);
+    m_open.assign(m_cells, 0);
+    m_loop.assign(m_cells, 0);
+    m_nonTree.clear();
+    m_mark.assign(m_cells, 0);
+    m_search = 0;
+
+    for (int y = 0; y < maze.height(); ++y)
+        for (int x = 0; x < maze.width(); ++x)
+            m_open[static_cast<size_t>(y) * m_width + x] = maze.openings(x, y) & (North | West);
+
+    // BFS forest. Each tree starts out as single-node splay trees hanging
+    // off their BFS parent by path-parent pointers, a valid link-cut state.
+    std::vector<uint8_t> seen(m_cells, 0);
+    std::vector<uint32_t> queue(m_cells);
+    const int32_t offsets[] = { -m_width, 1, m_width, -1 };
+    constexpr Direction DIRECTIONS[] = { North, East, South, West };
+
+    for (uint32_t root = 0; root < m_cells; ++root) {
+        if (seen[root]) continue;
+        seen[root] = 1;
+
+        size_t head = 0, tail = 0;
+        queue[tail++] = root;
+        while (head < tail) {
+            const uint32_t c = queue[head++];
+            const uint8_t open = maze.openings(c % m_width, c / m_width);
+
+            for (int d = 0; d < 4; ++d) {
+                if (!(open & DIRECTIONS[d])) continue;
+                const uint32_t n = c + offsets[d];
+                if (seen[n]) continue;
+
+                seen[n] = 1;
+                m_up[n] = c;
+                ++m_treeEdges;
+                queue[tail++] = n;
+            }
+        }
+    }
+
+    // Every open passage the BFS did not walk closes a loop
+    for (uint32_t c = 0; c < m_cells; ++c) {
+        if ((m_open[c] & North) && m_up[c] != c - m_width && m_up[c - m_width] != c) {
+            m_loop[c] |= North;
+            m_nonTree.insert(edgeKey(c, false));
+        }
+        if ((m_open[c] & West) && m_up[c] != c - 1 && m_up[c - 1] != c) {
+            m_loop[c] |= West;
+            m_nonTree.insert(edgeKey(c, true));
+        }
+    }
+}
+
+MazeConnectivity::Effect MazeConnectivity::editWall(const Maze& maze, const WallEdit& edit)
+{
+    // Normalise to the cell owning the wall and its North/West side
+    int ox = edit.x, oy = edit.y;
+    bool west = false;
+    switch (edit.dir) {
+        case North: break;
+        case South: ++oy; break;
+        case West:  west = true; break;
+        case East:  ++ox; west = true; break;
+    }
+
+    // Outer walls separate no cells
+    const int nx = west ? ox - 1 : ox;
+    const int ny = west ? oy : oy - 1;
+    if (nx < 0 || ny < 0 || ox >= maze.width() || oy >= maze.height() || !m_cells)
+        return Effect::Unchanged;
+
+    const uint32_t a = static_cast<uint32_t>(oy * m_width + ox);
+    const uint32_t b = static_cast<uint32_t>(ny * m_width + nx);
+    const uint8_t bit = west ? West : North;
+
+    const bool open = !maze.hasWall(ox, oy, west ? West : North);
+    if (open == ((m_open[a] & bit) != 0))
+        return Effect::Unchanged;
+
+    if (open) {
+        m_open[a] |= bit;
+        if (findRoot(a) == findRoot(b)) {
+            m_loop[a] |= bit;
+            m_nonTree.insert(edgeKey(a, west));
+            return Effect::LoopIntroduced;
+        }
+        link(a, b);
+        ++m_treeEdges;
+        return Effect::RegionsJoined;
+    }
+
+    m_open[a] &= ~bit;
+    if (m_loop[a] & bit) {
+        m_loop[a] &= ~bit;
+        m_nonTree.erase(edgeKey(a, west));
+        return Effect::LoopBroken;
+    }
+
+    cut(a, b);
+    --m_treeEdges;
+    return reconnect(a, b) ? Effect::LoopBroken : Effect::RegionIsolated;
+}
+
+bool MazeConnectivity::connected(int ax, int ay, int bx, int by)
+{
+    const int height = m_width ? static_cast<int>(m_cells / m_width) : 0;
+    auto inside = [&](int x, int y) { return x >= 0 && y >= 0 && x < m_width && y < height; };
+    if (!inside(ax, ay) || !inside(bx, by))
+        return false;
+
+    return findRoot(static_cast<uint32_t>(ay * m_width + ax)) ==
+           findRoot(static_cast<uint32_t>(by * m_width + bx));
+}
+
+MazeConnectivity::Status MazeConnectivity::status() const
+{
+    if (regionCount() > 1) return Status::Disconnected;
+    if (loopCount() > 0)   return Status::HasLoops;
+    return Status::Perfect;
+}
+
+size_t MazeConnectivity::memoryBytes() const
+{
+    // Set nodes approximated as key plus two pointers
+    return m_child.capacity() * sizeof(uint32_t) + m_up.capacity() * sizeof(uint32_t)
+         + m_flip.capacity() + m_open.capacity() + m_loop.capacity()
+         + m_nonTree.size() * (sizeof(uint32_t) + 2 * sizeof(void*))
+         + m_nonTree.bucket_count() * sizeof(void*)
+         + m_mark.capacity() * sizeof(uint32_t)
+         + (m_half[0].capacity() + m_half[1].capacity()) * sizeof(uint32_t);
+}
+
+bool MazeConnectivity::reconnect(uint32_t a, uint32_t b)
+{
+    if (m_nonTree.empty()) return false;
+
+    uint32_t key;
+    if (!searchHalves(a, b, m_nonTree.size() * CELLS_PER_LOOP, key))
+        key = scanLoops();
+    if (key == NONE) return false;
+
+    const uint32_t owner = key / 2;
+    const bool west = key & 1;
+    m_loop[owner] &= ~(west ? West : North);
+    m_nonTree.erase(key);
+    link(owner, west ? owner - 1 : owner - m_width);
+    ++m_treeEdges;
+    return true;
+}
+
+bool MazeConnectivity::searchHalves(uint32_t a, uint32_t b, size_t budget, uint32_t& key)
+{
+    // Two marks per search; on wrap-around, old marks could alias new ones
+    if (m_search >= UINT32_MAX - 2) {
+        std::fill(m_mark.begin(), m_mark.end(), 0);
+        m_search = 0;
+    }
+    m_search += 2;
+
+    const uint32_t starts[2] = { a, b };
+    size_t head[2] = { 0, 0 };
+    for (int side = 0; side < 2; ++side) {
+        m_half[side].clear();
+        m_half[side].push_back(starts[side]);
+        m_mark[starts[side]] = m_search + side;
+    }
+
+    // Open passages of c as (neighbour, key)
+    auto passages = [&](uint32_t c, auto&& fn) {
+        if (m_open[c] & North) fn(c - m_width, edgeKey(c, false));
+        if (m_open[c] & West)  fn(c - 1, edgeKey(c, true));
+        const uint32_t south = c + m_width;
+        if (south < m_cells && (m_open[south] & North)) fn(south, edgeKey(south, false));
+        if (c % m_width + 1 < static_cast<uint32_t>(m_width) && (m_open[c + 1] & West))
+            fn(c + 1, edgeKey(c + 1, true));
+    };
+    auto isLoop = [&](uint32_t k) { return (m_loop[k / 2] & ((k & 1) ? West : North)) != 0; };
+
+    // Grow each half a cell at a time, in turn, along tree edges. A loop
+    // edge reaching a cell already on the other side is a replacement.
+    key = NONE;
+    int done = -1;
+    for (int side = 0; key == NONE; side ^= 1) {
+        std::vector<uint32_t>& half = m_half[side];
+        if (head[side] == half.size()) {
+            done = side;
+            break;
+        }
+        if (head[0] + head[1] >= budget)
+            return false;
+
+        const uint32_t c = half[head[side]++];
+        passages(c, [&](uint32_t n, uint32_t k) {
+            if (!isLoop(k)) {
+                if (m_mark[n] != m_search + side) {
+                    m_mark[n] = m_search + side;
+                    half.push_back(n);
+                }
+            }
+            else if (key == NONE && m_mark[n] == m_search + (side ^ 1)) {
+                key = k;
+            }
+        });
+    }
+
+    // Otherwise one half ran out and is complete: any loop edge leaving it
+    // crosses to the other half
+    if (key == NONE) {
+        for (uint32_t c : m_half[done]) {
+            passages(c, [&](uint32_t n, uint32_t k) {
+                if (key == NONE && isLoop(k) && m_mark[n] != m_search + done)
+                    key = k;
+            });
+            if (key != NONE) break;
+        }
+    }
+    return true;
+}
+
+uint32_t MazeConnectivity::scanLoops()
+{
+    // Before the cut every non-tree edge joined two cells of one tree, so
+    // one whose ends now have different roots spans the two halves
+    for (uint32_t key : m_nonTree) {
+        const uint32_t a = key / 2;
+        const uint32_t b = (key & 1) ? a - 1 : a - m_width;
+        if (findRoot(a) != findRoot(b))
+            return key;
+    }
+    return NONE;
+}
+
+// --- Link-cut tree ---
+
+bool MazeConnectivity::isSplayRoot(uint32_t x) const
+{
+    const uint32_t p = m_up[x];
+    return p == NONE || (m_child[2 * p] != x && m_child[2 * p + 1] != x);
+}
+
+void MazeConnectivity::pushFlip(uint32_t x)
+{
+    if (!m_flip[x]) return;
+
+    std::swap(m_child[2 * x], m_child[2 * x + 1]);
+    for (int d = 0; d < 2; ++d)
+        if (m_child[2 * x + d] != NONE)
+            m_flip[m_child[2 * x + d]] ^= 1;
+    m_flip[x] = 0;
+}
+
+void MazeConnectivity::rotate(uint32_t x)
+{
+    const uint32_t p = m_up[x];
+    const uint32_t g = m_up[p];
+    const int d = m_child[2 * p + 1] == x ? 1 : 0;
+    const uint32_t inner = m_child[2 * x + (d ^ 1)];
+
+    // Keep g's child link, or the path-parent pointer if p was a splay root
+    if (!isSplayRoot(p))
+        m_child[2 * g + (m_child[2 * g + 1] == p ? 1 : 0)] = x;
+    m_up[x] = g;
+
+    m_child[2 * p + d] = inner;
+    if (inner != NONE) m_up[inner] = p;
+
+    m_child[2 * x + (d ^ 1)] = p;
+    m_up[p] = x;
+}
+
+void MazeConnectivity::splay(uint32_t x)
+{
+    // Reversals are pushed down top to bottom before any rotation
+    m_stack.clear();
+    m_stack.push_back(x);
+    for (uint32_t y = x; !isSplayRoot(y); y = m_up[y])
+        m_stack.push_back(m_up[y]);
+    for (size_t i = m_stack.size(); i-- > 0;)
+        pushFlip(m_stack[i]);
+
+    while (!isSplayRoot(x)) {
+        const uint32_t p = m_up[x];
+        if (!isSplayRoot(p)) {
+            const uint32_t g = m_up[p];
+            const bool zigZig = (m_child[2 * g] == p) == (m_child[2 * p] == x);
+            rotate(zigZig ? p : x);
+        }
+        rotate(x);
+    }
+}
+
+void MazeConnectivity::access(uint32_t x)
+{
+    uint32_t last = NONE;
+    for (uint32_t y = x; y != NONE; y = m_up[y]) {
+        splay(y);
+        m_child[2 * y + 1] = last;
+        last = y;
+    }
+    splay(x);
+}
+
+void MazeConnectivity::makeRoot(uint32_t x)
+{
+    access(x);
+    m_flip[x] ^= 1;
+}
+
+uint32_t MazeConnectivity::findRoot(uint32_t x)
+{
+    access(x);
+    for (;;) {
+        pushFlip(x);
+        if (m_child[2 * x] == NONE) break;
+        x = m_child[2 * x];
+    }
+    splay(x);
+    return x;
+}
+
+void MazeConnectivity::link(uint32_t a, uint32_t b)
+{
+    makeRoot(a);
+    m_up[a] = b;
+}
+
+void MazeConnectivity::cut(uint32_t a, uint32_t b)
+{
+    // With a as root, the path to its neighbour b is exactly { a, b }
+    makeRoot(a);
+    access(b);
+    m_child[2 * b] = NONE;
+    m_up[a] = NONE;
+}
+
+} // namespace engine
@@ -0,0 +1,291 @@
+#include "engine/maze/MazeDistanceField.h"
+#include "engine/core/Cpu.h"
+#include "engine/maze/Maze.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(MAZE3D_X86_64)
+#include <immintrin.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+constexpr float CELL = 1.0f;
+constexpr float WALL_HEIGHT = 1.0f;
+constexpr float WALL_THICKNESS = 0.1f;
+
+// Cells of field around the maze, so border walls and spheres just
+// outside them still see a gradient
+constexpr int MARGIN = 1;
+
+// Distances are clamped here (in cells). Every box within this distance of
+// a point is a wall of its cell or touches one of its corners.
+constexpr float MAX_DISTANCE = 0.5f;
+
+// Fixed point: stored value = distance in cells * SCALE
+constexpr float SCALE = 4096.0f;
+
+// Corrections per resolve; the first usually clears the walls, the rest
+// settle corners where two walls push at once
+constexpr int MAX_PUSHES = 4;
+
+// Closer than this counts as clear, so a push that lands on the surface
+// is not refined by a further sample
+constexpr float TOLERANCE = 1e-4f;
+
+struct Box {
+    float minX, maxX, minZ, maxZ;
+};
+
+// Wall on the horizontal grid line z = line, from x = col to col + 1.
+// Line `height` is the south border.
+bool horizontalWall(const Maze& maze, int col, int line)
+{
+    if (col < 0 || col >= maze.width() || line < 0 || line > maze.height()) return false;
+    if (line == maze.height()) return maze.southBorder(col);
+    return (maze.northRow(line)[col >> 6] >> (col & 63)) & 1u;
+}
+
+// Wall on the vertical grid line x = line, from z = row to row + 1.
+// Line `width` is the east border.
+bool verticalWall(const Maze& maze, int row, int line)
+{
+    if (row < 0 || row >= maze.height() || line < 0 || line > maze.width()) return false;
+    if (line == maze.width()) return maze.eastBorder(row);
+    return (maze.westRow(row)[line >> 6] >> (line & 63)) & 1u;
+}
+
+// MazeCollider gives a wall one box per cell beside it, each a thickness
+// deep on that cell's neighbour's side; together they span both sides of
+// the line, and a border wall only the outer one.
+Box horizontalBox(const Maze& maze, int col, int line)
+{
+    return { static_cast<float>(col), static_cast<float>(col + 1),
+             line - (line < maze.height() ? WALL_THICKNESS : 0.0f),
+             line + (line > 0 ? WALL_THICKNESS : 0.0f) };
+}
+
+Box verticalBox(const Maze& maze, int row, int line)
+{
+    return { line - (line < maze.width() ? WALL_THICKNESS : 0.0f),
+             line + (line > 0 ? WALL_THICKNESS : 0.0f),
+             static_cast<float>(row), static_cast<float>(row + 1) };
+}
+
+float boxDistance(float x, float z, const Box& b)
+{
+    const float qx = std::max(b.minX - x, x - b.maxX);
+    const float qz = std::max(b.minZ - z, z - b.maxZ);
+    const float ox = std::max(qx, 0.0f);
+    const float oz = std::max(qz, 0.0f);
+    return std::sqrt(ox * ox + oz * oz) + std::min(std::max(qx, qz), 0.0f);
+}
+
+} // namespace
+
+void MazeDistanceField::build(const Maze& maze, int samplesPerCell, int originX, int originY)
+{
+    m_width = maze.width();
+    m_height = maze.height();
+    m_originX = originX;
+    m_originY = originY;
+    m_samplesPerCell = std::max(samplesPerCell, 1);
+
+    m_samplesX = (m_width + 2 * MARGIN) * m_samplesPerCell + 1;
+    m_samplesZ = (m_height + 2 * MARGIN) * m_samplesPerCell + 1;
+    m_tilesX = (m_samplesX + TILE - 1) / TILE;
+    m_tilesZ = (m_samplesZ + TILE - 1) / TILE;
+
+    m_samples.assign(static_cast<size_t>(m_samplesX) * m_samplesZ, 0);
+    bake(maze, 0, 0, m_samplesX, m_samplesZ);
+}
+
+void MazeDistanceField::bake(const Maze& maze, int i0, int j0, int i1, int j1)
+{
+    const int res = m_samplesPerCell;
+    const float step = 1.0f / res;
+
+    // Cell by cell, so the walls near a cell are looked up once for all
+    // of its samples. Sample i sits at x = i / res - MARGIN in maze cells.
+    for (int cy = j0 / res - MARGIN; cy <= (j1 - 1) / res - MARGIN; ++cy) {
+        for (int cx = i0 / res - MARGIN; cx <= (i1 - 1) / res - MARGIN; ++cx) {
+            // The cell's own walls, and those meeting its corners from outside
+            Box boxes[12];
+            int count = 0;
+            for (int line = cy; line <= cy + 1; ++line)
+                for (int col = cx - 1; col <= cx + 1; ++col)
+                    if (horizontalWall(maze, col, line))
+                        boxes[count++] = horizontalBox(maze, col, line);
+            for (int line = cx; line <= cx + 1; ++line)
+                for (int row = cy - 1; row <= cy + 1; ++row)
+                    if (verticalWall(maze, row, line))
+                        boxes[count++] = verticalBox(maze, row, line);
+
+            const int si0 = std::max((cx + MARGIN) * res, i0);
+            const int si1 = std::min((cx + MARGIN + 1) * res, i1);
+            const int sj0 = std::max((cy + MARGIN) * res, j0);
+            const int sj1 = std::min((cy + MARGIN + 1) * res, j1);
+
+            for (int j = sj0; j < sj1; ++j) {
+                const float z = j * step - MARGIN;
+                for (int i = si0; i < si1; ++i) {
+                    const float x = i * step - MARGIN;
+
+                    float d = MAX_DISTANCE;
+                    for (int b = 0; b < count; ++b)
+                        d = std::min(d, boxDistance(x, z, boxes[b]));
+
+                    m_samples[sampleIndex(i, j)] = static_cast<int16_t>(std::lround(d * SCALE));
+                }
+            }
+        }
+    }
+}
+
+size_t MazeDistanceField::editWall(const Maze& maze, const WallEdit& edit)
+{
+    if (m_samples.empty()) return 0;
+    if (edit.x < 0 || edit.y < 0 || edit.x >= m_width || edit.y >= m_height) return 0;
+
+    // The wall's box, in maze cells
+    Box box;
+    switch (edit.dir) {
+        case North: box = horizontalBox(maze, edit.x, edit.y);     break;
+        case South: box = horizontalBox(maze, edit.x, edit.y + 1); break;
+        case West:  box = verticalBox(maze, edit.y, edit.x);       break;
+        default:    box = verticalBox(maze, edit.y, edit.x + 1);   break;
+    }
+
+    // Samples within MAX_DISTANCE of it, rounded out to whole tiles
+    const float res = static_cast<float>(m_samplesPerCell);
+    auto toSample = [&](float cells) { return static_cast<int>(std::floor((cells + MARGIN) * res)); };
+
+    const int ti0 = std::max(toSample(box.minX - MAX_DISTANCE), 0) / TILE;
+    const int tj0 = std::max(toSample(box.minZ - MAX_DISTANCE), 0) / TILE;
+    const int ti1 = std::min(toSample(box.maxX + MAX_DISTANCE) + 1, m_samplesX - 1) / TILE;
+    const int tj1 = std::min(toSample(box.maxZ + MAX_DISTANCE) + 1, m_samplesZ - 1) / TILE;
+
+    bake(maze, ti0 * TILE, tj0 * TILE,
+         std::min((ti1 + 1) * TILE, m_samplesX), std::min((tj1 + 1) * TILE, m_samplesZ));
+
+    return static_cast<size_t>(ti1 - ti0 + 1) * (tj1 - tj0 + 1);
+}
+
+float MazeDistanceField::sample(float x, float z, glm::vec2& gradient) const
+{
+    gradient = glm::vec2(0.0f);
+    if (m_samples.empty()) return MAX_DISTANCE * CELL;
+
+    const float res = static_cast<float>(m_samplesPerCell);
+    const float gx = (x / CELL - m_originX + MARGIN) * res;
+    const float gz = (z / CELL - m_originY + MARGIN) * res;
+    if (!(gx >= 0.0f && gz >= 0.0f && gx < m_samplesX - 1 && gz < m_samplesZ - 1))
+        return MAX_DISTANCE * CELL;
+
+    const int i = static_cast<int>(gx);
+    const int j = static_cast<int>(gz);
+    const float tx = gx - i;
+    const float tz = gz - j;
+
+    const int16_t* s = &m_samples[sampleIndex(i, j)];
+    const float d00 = s[0];
+    const float d10 = s[1];
+    const float d01 = s[m_samplesX];
+    const float d11 = s[m_samplesX + 1];
+
+    // Fixed point per sample step, to world distance per world unit
+    const float slope = res / SCALE;
+    gradient.x = ((d10 - d00) * (1.0f - tz) + (d11 - d01) * tz) * slope;
+    gradient.y = ((d01 - d00) * (1.0f - tx) + (d11 - d10) * tx) * slope;
+
+    const float top = d00 + (d10 - d00) * tx;
+    const float bottom = d01 + (d11 - d01) * tx;
+    return (top + (bottom - top) * tz) * (CELL / SCALE);
+}
+
+float MazeDistanceField::distance(float x, float z) const
+{
+    glm::vec2 gradient;
+    return sample(x, z, gradient);
+}
+
+void MazeDistanceField::resolve(glm::vec3& pos, float radius) const
+{
+    // Walls are vertical, so height only narrows the circle the sphere cuts
+    const float dy = std::max(0.0f, std::min(pos.y, WALL_HEIGHT)) - pos.y;
+    if (dy * dy >= radius * radius) return;
+    const float r = std::sqrt(radius * radius - dy * dy);
+
+    for (int i = 0; i < MAX_PUSHES; ++i) {
+        glm::vec2 gradient;
+        const float d = sample(pos.x, pos.z, gradient);
+        if (d >= r - TOLERANCE) break;
+
+        // Newton step on the interpolated field: lands on d = r in one
+        // go wherever the field is linear, which is nearly everywhere.
+        // Where it flattens (a wall's core, a ridge between two walls) the
+        // step is capped at twice the overlap.
+        const float slope = glm::length(gradient);
+        if (slope < 1e-3f) break;
+
+        const glm::vec2 push = gradient * ((r - d) / (slope * std::max(slope, 0.5f)));
+        pos.x += push.x;
+        pos.z += push.y;
+    }
+}
+
+void MazeDistanceField::prefetch(const glm::vec3& pos) const
+{
+#if defined(MAZE3D_X86_64)
+    const float res = static_cast<float>(m_samplesPerCell);
+    const float gx = (pos.x / CELL - m_originX + MARGIN) * res;
+    const float gz = (pos.z / CELL - m_originY + MARGIN) * res;
+    if (!(gx >= 0.0f && gz >= 0.0f && gx < m_samplesX - 1 && gz < m_samplesZ - 1))
+        return;
+
+    const int16_t* s = &m_samples[sampleIndex(static_cast<int>(gx), static_cast<int>(gz))];
+    _mm_prefetch(reinterpret_cast<const char*>(s), _MM_HINT_T0);
+    _mm_prefetch(reinterpret_cast<const char*>(s + m_samplesX), _MM_HINT_T0);
+#else
+    (void)pos;
+#endif
+}
+
+void MazeDistanceField::resolve(std::span<glm::vec3> positions, std::span<const float> radii) const
+{
+    // As MazeCollider: overlap the next agents' misses with this one
+    constexpr size_t AHEAD = 8;
+
+    const size_t count = std::min(positions.size(), radii.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (i + AHEAD < count)
+            prefetch(positions[i + AHEAD]);
+        resolve(positions[i], radii[i]);
+    }
+}
+
+void MazeDistanceField::resolve(std::span<glm::vec3> positions, float radius) const
+{
+    constexpr size_t AHEAD = 8;
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        if (i + AHEAD < positions.size())
+            prefetch(positions[i + AHEAD]);
+        resolve(positions[i], radius);
+    }
+}
+
+float MazeDistanceField::maxDistance() const
+{
+    return MAX_DISTANCE * CELL;
+}
+
+size_t MazeDistanceField::memoryBytes() const
+{
+    return m_samples.capacity() * sizeof(int16_t);
+}
+
+} // namespace engine
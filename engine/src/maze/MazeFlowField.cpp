@@ -0,0 +1,205 @@
+#include "engine/maze/MazeFlowField.h"
+#include "engine/maze/Maze.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace engine {
+
+namespace {
+
+constexpr Direction DIRECTIONS[] = { North, East, South, West };
+
+Direction opposite(Direction dir)
+{
+    switch (dir) {
+        case North: return South;
+        case South: return North;
+        case West:  return East;
+        default:    return West;
+    }
+}
+
+} // namespace
+
+void MazeFlowField::build(const Maze& maze, int goalX, int goalY)
+{
+    m_width = maze.width();
+    m_height = maze.height();
+    m_goalX = goalX;
+    m_goalY = goalY;
+
+    const size_t cells = static_cast<size_t>(m_width) * m_height;
+    m_dist.assign(cells, UNREACHABLE);
+    m_next.assign(cells, 0);
+    m_queue.resize(cells);
+    m_inSubtree.assign(cells, 0);
+    m_repaired = cells;
+
+    if (goalX < 0 || goalY < 0 || goalX >= m_width || goalY >= m_height)
+        return;
+
+    const uint32_t goal = static_cast<uint32_t>(index(goalX, goalY));
+    m_dist[goal] = 0;
+    m_queue[0] = goal;
+
+    size_t head = 0, tail = 1;
+    const int32_t offsets[] = { -m_width, 1, m_width, -1 };   // matches DIRECTIONS
+
+    while (head < tail) {
+        const uint32_t c = m_queue[head++];
+        const uint8_t open = maze.openings(c % m_width, c / m_width);
+
+        for (int d = 0; d < 4; ++d) {
+            if (!(open & DIRECTIONS[d])) continue;
+            const uint32_t n = c + offsets[d];
+            if (m_dist[n] != UNREACHABLE) continue;
+
+            m_dist[n] = m_dist[c] + 1;
+            m_next[n] = opposite(DIRECTIONS[d]);
+            m_queue[tail++] = n;
+        }
+    }
+}
+
+void MazeFlowField::editWall(const Maze& maze, const WallEdit& edit)
+{
+    m_repaired = 0;
+
+    int nx = edit.x, ny = edit.y;
+    switch (edit.dir) {
+        case North: --ny; break;
+        case South: ++ny; break;
+        case West:  --nx; break;
+        case East:  ++nx; break;
+    }
+
+    auto inside = [&](int x, int y) { return x >= 0 && y >= 0 && x < m_width && y < m_height; };
+    if (!inside(edit.x, edit.y) || !inside(nx, ny))
+        return;
+
+    const uint32_t a = static_cast<uint32_t>(index(edit.x, edit.y));
+    const uint32_t b = static_cast<uint32_t>(index(nx, ny));
+
+    if (!edit.add) {
+        // Only one side can improve through the new opening
+        lower(maze, a, b, opposite(edit.dir));
+        lower(maze, b, a, edit.dir);
+        return;
+    }
+
+    // Only a tree edge matters: the cell that stepped through it loses its
+    // path, and with it every cell whose path ran through that cell
+    if (m_next[a] == edit.dir)
+        raise(maze, a);
+    else if (m_next[b] == opposite(edit.dir))
+        raise(maze, b);
+}
+
+void MazeFlowField::lower(const Maze& maze, uint32_t from, uint32_t to, Direction toFrom)
+{
+    if (m_dist[from] == UNREACHABLE || m_dist[from] + 1 >= m_dist[to])
+        return;
+
+    m_dist[to] = m_dist[from] + 1;
+    m_next[to] = toFrom;
+    m_queue[0] = to;
+
+    // Unit steps from a single seed: FIFO order is distance order
+    size_t head = 0, tail = 1;
+    const int32_t offsets[] = { -m_width, 1, m_width, -1 };
+
+    while (head < tail) {
+        const uint32_t c = m_queue[head++];
+        const uint8_t open = maze.openings(c % m_width, c / m_width);
+
+        for (int d = 0; d < 4; ++d) {
+            if (!(open & DIRECTIONS[d])) continue;
+            const uint32_t n = c + offsets[d];
+            if (m_dist[c] + 1 >= m_dist[n]) continue;
+
+            m_dist[n] = m_dist[c] + 1;
+            m_next[n] = opposite(DIRECTIONS[d]);
+            m_queue[tail++] = n;
+        }
+    }
+    m_repaired = tail;
+}
+
+void MazeFlowField::raise(const Maze& maze, uint32_t root)
+{
+    const int32_t offsets[] = { -m_width, 1, m_width, -1 };
+
+    // 1. The subtree, level by level: neighbours whose next step leads here
+    size_t tail = 0;
+    m_queue[tail++] = root;
+    m_inSubtree[root] = 1;
+
+    for (size_t head = 0; head < tail; ++head) {
+        const uint32_t c = m_queue[head];
+        const uint8_t open = maze.openings(c % m_width, c / m_width);
+
+        for (int d = 0; d < 4; ++d) {
+            if (!(open & DIRECTIONS[d])) continue;
+            const uint32_t n = c + offsets[d];
+            if (!m_inSubtree[n] && m_next[n] == opposite(DIRECTIONS[d])) {
+                m_inSubtree[n] = 1;
+                m_queue[tail++] = n;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < tail; ++i) {
+        m_dist[m_queue[i]] = UNREACHABLE;
+        m_next[m_queue[i]] = 0;
+    }
+
+    // 2. Seed each subtree cell from its best neighbour outside the subtree
+    m_heap.clear();
+    for (size_t i = 0; i < tail; ++i) {
+        const uint32_t c = m_queue[i];
+        const uint8_t open = maze.openings(c % m_width, c / m_width);
+
+        for (int d = 0; d < 4; ++d) {
+            if (!(open & DIRECTIONS[d])) continue;
+            const uint32_t n = c + offsets[d];
+            if (m_inSubtree[n] || m_dist[n] == UNREACHABLE || m_dist[n] + 1 >= m_dist[c])
+                continue;
+
+            m_dist[c] = m_dist[n] + 1;
+            m_next[c] = DIRECTIONS[d];
+        }
+
+        if (m_dist[c] != UNREACHABLE)
+            m_heap.push_back((static_cast<uint64_t>(m_dist[c]) << 32) | c);
+    }
+
+    // 3. Dijkstra inside the subtree from those seeds
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<>{});
+    while (!m_heap.empty()) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<>{});
+        const uint64_t top = m_heap.back();
+        m_heap.pop_back();
+
+        const uint32_t c = static_cast<uint32_t>(top);
+        if (static_cast<uint32_t>(top >> 32) != m_dist[c]) continue;
+
+        const uint8_t open = maze.openings(c % m_width, c / m_width);
+        for (int d = 0; d < 4; ++d) {
+            if (!(open & DIRECTIONS[d])) continue;
+            const uint32_t n = c + offsets[d];
+            if (!m_inSubtree[n] || m_dist[c] + 1 >= m_dist[n]) continue;
+
+            m_dist[n] = m_dist[c] + 1;
+            m_next[n] = opposite(DIRECTIONS[d]);
+            m_heap.push_back((static_cast<uint64_t>(m_dist[n]) << 32) | n);
+            std::push_heap(m_heap.begin(), m_heap.end(), std::greater<>{});
+        }
+    }
+
+    for (size_t i = 0; i < tail; ++i)
+        m_inSubtree[m_queue[i]] = 0;
+    m_repaired = tail;
+}
+
+} // namespace engine
@@ -0,0 +1,32 @@
+#include "engine/maze/MazeGenerator.h"
+
+namespace engine {
+
+std::unique_ptr<MazeGenerator> createMazeGenerator(const std::string& name)
+{
+    if (name == "backtracker") return std::make_unique<BacktrackerGenerator>();
+    if (name == "kruskal")     return std::make_unique<KruskalGenerator>();
+    if (name == "prim")        return std::make_unique<PrimGenerator>();
+    if (name == "wilson")      return std::make_unique<WilsonGenerator>();
+    if (name == "eller")       return std::make_unique<EllerGenerator>();
+    if (name == "binary-tree") return std::make_unique<BinaryTreeGenerator>();
+    if (name == "sidewinder")  return std::make_unique<SidewinderGenerator>();
+
+    return nullptr;
+}
+
+const std::vector<std::string>& mazeGeneratorNames()
+{
+    static const std::vector<std::string> names = {
+        "backtracker",
+        "kruskal",
+        "prim",
+        "wilson",
+        "eller",
+        "binary-tree",
+        "sidewinder"
+    };
+    return names;
+}
+
+} // namespace engine
@@ -1,217 +1,646 @@
 #include "engine/maze/MazeMesh.h"
+#include "engine/core/ThreadPool.h"
 #include "engine/maze/Maze.h"
 #include "engine/maze/MazeTypes.h"
+#include "engine/maze/MazeWallRuns.h"
 #include "engine/render/Shader.h"
+#include "engine/scene/Frustum.h"
 
 #include <vector>
 #include <utility>
-#include <functional> // std::hash
-#include <unordered_map>
 #include <algorithm>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
-#include <iostream>
 
 
 
 namespace engine {
 
+namespace {
 
+// One wall box: 8 shared corners, positions only
+constexpr size_t CORNERS = 8;
+constexpr size_t FLOATS_PER_BOX = CORNERS * 3;
 
-// -------------------- Constructor / Destructor --------------------
-MazeMesh::MazeMesh() {
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
+// Two sides, two end caps and the top; the bottom is never seen
+constexpr size_t MAX_FACES = 5;
+
+// Spare GPU slots per chunk on top of the proportional headroom
+constexpr size_t GROWTH_SLOTS = 16;
+
+// Corners 0-3 lie at -z, 4-7 at +z (see writeBox). Each face is two
+// triangles, counter-clockwise seen from outside the box.
+enum Face { FACE_NEG_Z, FACE_POS_Z, FACE_NEG_X, FACE_POS_X, FACE_TOP };
+
+constexpr uint32_t FACE_INDICES[][6] = {
+    { 0,2,1, 0,3,2 },   // -z
+    { 4,5,6, 4,6,7 },   // +z
+    { 0,4,7, 0,7,3 },   // -x
+    { 1,2,6, 1,6,5 },   // +x
+    { 3,7,6, 3,6,2 },   // top
+};
+
+// What the unindexed mesh spent per wall
+constexpr size_t UNINDEXED_VERTICES = 36;
+
+// The one-wall segments that meet grid vertex (vx, vz), some possibly off
+// the maze
+void wallsMeeting(int vx, int vz, WallRun (&out)[4])
+{
+    out[0] = WallRun{ true,  vz, vx - 1, vx };
+    out[1] = WallRun{ true,  vz, vx, vx + 1 };
+    out[2] = WallRun{ false, vx, vz - 1, vz };
+    out[3] = WallRun{ false, vx, vz, vz + 1 };
 }
 
+} // namespace
+
+MazeMesh::MazeMesh(const MazeConfig& config)
+    : m_config(config),
+      m_indicesPerSlot((config.ceiling ? MAX_FACES - 1 : MAX_FACES) * 6)
+{
+}
+
+// -------------------- Destructor --------------------
 MazeMesh::~MazeMesh() {
-    glDeleteBuffers(1, &m_vbo);
-    glDeleteVertexArrays(1, &m_vao);
+    for (const ChunkBuffers& gpu : m_buffers) {
+        if (gpu.ebo) glDeleteBuffers(1, &gpu.ebo);
+        if (gpu.vbo) glDeleteBuffers(1, &gpu.vbo);
+        if (gpu.vao) glDeleteVertexArrays(1, &gpu.vao);
+    }
 }
 
 // -------------------- Full Maze Build --------------------
-void MazeMesh::build(const Maze& maze)
+void MazeMesh::build(const Maze& maze, int originX, int originY, ThreadPool* pool)
 {
-    m_vertices.clear();
-    m_cellRanges.clear();
+    buildGeometry(maze, originX, originY, pool);
+    upload();
+}
 
-    for (int y = 0; y < maze.height(); ++y)
-    {
-        for (int x = 0; x < maze.width(); ++x)
-        {
-            rebuildCell(x, y, maze);
+void MazeMesh::buildGeometry(const Maze& maze, int originX, int originY, ThreadPool* pool)
+{
+    m_width = maze.width();
+    m_height = maze.height();
+    m_originX = originX;
+    m_originY = originY;
+
+    const size_t cells = static_cast<size_t>(m_width) * m_height;
+    m_wallSlot.assign(cells * 2 + m_width + m_height, NO_SLOT);
+    m_wallCount = 0;
+
+    // Fixed bounds: the chunk's cells, grown by half a wall thickness
+    // and up to the wall height
+    const float cell = m_config.cellSize;
+    const float t = m_config.wallThickness * 0.5f;
+    m_chunksX = (m_width + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    const int chunksY = (m_height + CHUNK_CELLS - 1) / CHUNK_CELLS;
+
+    m_chunks.assign(static_cast<size_t>(m_chunksX) * chunksY, Chunk{});
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < m_chunksX; ++cx) {
+            const int x0 = cx * CHUNK_CELLS, x1 = std::min(m_width, x0 + CHUNK_CELLS);
+            const int y0 = cy * CHUNK_CELLS, y1 = std::min(m_height, y0 + CHUNK_CELLS);
+
+            Chunk& chunk = m_chunks[static_cast<size_t>(cy) * m_chunksX + cx];
+            chunk.min = glm::vec3((m_originX + x0) * cell - t, 0.0f, (m_originY + y0) * cell - t);
+            chunk.max = glm::vec3((m_originX + x1) * cell + t, m_config.wallHeight, (m_originY + y1) * cell + t);
         }
     }
 
-    m_vertexCount = static_cast<GLsizei>(m_vertices.size() / 3);
+    // Each chunk writes only its own slots and its own walls' entries in
+    // m_wallSlot. End caps look at the neighbours' walls, so indexing waits
+    // until every chunk has its runs.
+    std::vector<size_t> walls(m_chunks.size(), 0);
+    if (pool) {
+        pool->parallelFor(m_chunks.size(), [&](size_t c, unsigned) {
+            walls[c] = meshChunk(maze, static_cast<uint32_t>(c));
+        });
+        pool->parallelFor(m_chunks.size(), [&](size_t c, unsigned) {
+            indexChunk(static_cast<uint32_t>(c));
+        });
+    }
+    else {
+        for (uint32_t c = 0; c < m_chunks.size(); ++c)
+            walls[c] = meshChunk(maze, c);
+        for (uint32_t c = 0; c < m_chunks.size(); ++c)
+            indexChunk(c);
+    }
+
+    for (size_t count : walls)
+        m_wallCount += count;
+    m_dirtyChunks.clear();
+}
+
+size_t MazeMesh::meshChunk(const Maze& maze, uint32_t c)
+{
+    Chunk& chunk = m_chunks[c];
+    const int x0 = static_cast<int>(c % m_chunksX) * CHUNK_CELLS;
+    const int y0 = static_cast<int>(c / m_chunksX) * CHUNK_CELLS;
+    const int x1 = x0 + CHUNK_CELLS;
+    const int y1 = y0 + CHUNK_CELLS;
+
+    size_t runs = 0;
+    forEachWallRun(maze, x0, y0, x1, y1, [&](const WallRun&) { ++runs; });
+
+    chunk.slotRun.resize(runs);
+    chunk.slotTriangles.assign(runs, 0);
+    chunk.vertices.resize(runs * FLOATS_PER_BOX);
+    chunk.indices.resize(runs * m_indicesPerSlot);
+
+    uint32_t slot = 0;
+    size_t walls = 0;
+    forEachWallRun(maze, x0, y0, x1, y1, [&](const WallRun& run) {
+        chunk.slotRun[slot] = run;
+        for (int at = run.begin; at < run.end; ++at)
+            m_wallSlot[runWall(run, at)] = slot;
+        boxVertices(run, &chunk.vertices[slot * FLOATS_PER_BOX]);
+        walls += run.length();
+        ++slot;
+    });
+    return walls;
+}
+
+void MazeMesh::indexChunk(uint32_t c)
+{
+    Chunk& chunk = m_chunks[c];
+    chunk.triangles = 0;
+    for (uint32_t slot = 0; slot < chunk.slotRun.size(); ++slot) {
+        const int faces = slotIndices(chunk.slotRun[slot], slot, &chunk.indices[slot * m_indicesPerSlot]);
+        chunk.slotTriangles[slot] = static_cast<uint8_t>(faces * 2);
+        chunk.triangles += faces * 2;
+    }
+}
+
+size_t MazeMesh::boxCount() const
+{
+    size_t boxes = 0;
+    for (const Chunk& chunk : m_chunks)
+        boxes += chunk.slotRun.size();
+    return boxes;
+}
+
+MazeMesh::Stats MazeMesh::stats() const
+{
+    Stats s;
+    s.chunks = m_chunks.size();
+    s.walls = m_wallCount;
+    for (const Chunk& chunk : m_chunks) {
+        s.boxes += chunk.slotRun.size();
+        s.triangles += chunk.triangles;
+        s.bytes += chunk.vertices.size() * sizeof(float) + chunk.indices.size() * sizeof(uint32_t);
+    }
+    s.vertices = s.boxes * CORNERS;
+    s.unindexedVertices = s.walls * UNINDEXED_VERTICES;
+    s.unindexedTriangles = s.walls * 12;
+    s.unindexedBytes = s.unindexedVertices * 3 * sizeof(float);
+    return s;
+}
+
+void MazeMesh::upload()
+{
+    for (uint32_t c = 0; c < m_chunks.size(); ++c)
+        uploadChunk(c);
+
+    // A rebuild may have left fewer chunks than there are buffers
+    while (m_buffers.size() > m_chunks.size()) {
+        const ChunkBuffers& gpu = m_buffers.back();
+        if (gpu.ebo) glDeleteBuffers(1, &gpu.ebo);
+        if (gpu.vbo) glDeleteBuffers(1, &gpu.vbo);
+        if (gpu.vao) glDeleteVertexArrays(1, &gpu.vao);
+        m_buffers.pop_back();
+    }
+
+    m_dirtyChunks.clear();
+}
 
-    glBindVertexArray(m_vao);
+void MazeMesh::uploadChunk(uint32_t c)
+{
+    Chunk& chunk = m_chunks[c];
+    if (m_buffers.size() <= c) m_buffers.resize(c + 1);
+    ChunkBuffers& gpu = m_buffers[c];
+
+    if (!gpu.vao) {
+        glGenVertexArrays(1, &gpu.vao);
+        glGenBuffers(1, &gpu.vbo);
+        glGenBuffers(1, &gpu.ebo);
+    }
+
+    // Headroom for runs added later, so edits rarely have to regrow it
+    const size_t slots = chunk.slotRun.size();
+    gpu.slots = slots + slots / 4 + GROWTH_SLOTS;
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBindVertexArray(gpu.vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, gpu.vbo);
     glBufferData(GL_ARRAY_BUFFER,
-                 m_vertices.size() * sizeof(float),
-                 m_vertices.data(),
+                 gpu.slots * FLOATS_PER_BOX * sizeof(float),
+                 nullptr,
                  GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, chunk.vertices.size() * sizeof(float), chunk.vertices.data());
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 gpu.slots * m_indicesPerSlot * sizeof(uint32_t),
+                 nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, chunk.indices.size() * sizeof(uint32_t), chunk.indices.data());
+
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
     glBindVertexArray(0);
-    std::cout << "Vertex count: " << m_vertexCount << std::endl;
+
+    gpu.indexCount = static_cast<GLsizei>(chunk.indices.size());
+    chunk.dirtyVertices.clear();
+    chunk.dirtyIndices.clear();
+}
+
+void MazeMesh::uploadDirty()
+{
+    const size_t vertexBytes = FLOATS_PER_BOX * sizeof(float);
+    const size_t indexBytes = m_indicesPerSlot * sizeof(uint32_t);
+
+    for (uint32_t c : m_dirtyChunks) {
+        Chunk& chunk = m_chunks[c];
+        const size_t slots = chunk.slotRun.size();
+
+        // Out of room (or never uploaded): send the whole chunk, with headroom
+        if (c >= m_buffers.size() || !m_buffers[c].vao || slots > m_buffers[c].slots) {
+            uploadChunk(c);
+            m_lastUploadBytes += slots * (vertexBytes + indexBytes);
+            continue;
+        }
+
+        ChunkBuffers& gpu = m_buffers[c];
+        glBindVertexArray(gpu.vao);
+        uploadRuns(gpu, GL_ARRAY_BUFFER, chunk.dirtyVertices, slots, vertexBytes, chunk.vertices.data());
+        uploadRuns(gpu, GL_ELEMENT_ARRAY_BUFFER, chunk.dirtyIndices, slots, indexBytes, chunk.indices.data());
+        glBindVertexArray(0);
+
+        gpu.indexCount = static_cast<GLsizei>(chunk.indices.size());
+    }
+
+    m_dirtyChunks.clear();
+}
+
+void MazeMesh::uploadRuns(const ChunkBuffers& gpu, GLenum target, std::vector<uint32_t>& dirty,
+                          size_t slots, size_t slotBytes, const void* data)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+
+    glBindBuffer(target, target == GL_ARRAY_BUFFER ? gpu.vbo : gpu.ebo);
+
+    // Runs of adjacent dirty slots go up in one call. Slots past the end
+    // were freed; nothing draws them.
+    std::sort(dirty.begin(), dirty.end());
+    for (size_t i = 0; i < dirty.size();) {
+        const uint32_t first = dirty[i];
+        uint32_t last = first;
+        while (++i < dirty.size() && dirty[i] <= last + 1)
+            last = dirty[i];
+
+        if (first >= slots) break;
+        last = std::min<uint32_t>(last, static_cast<uint32_t>(slots - 1));
+
+        const size_t size = (last - first + 1) * slotBytes;
+        glBufferSubData(target, first * slotBytes, size, bytes + first * slotBytes);
+        m_lastUploadBytes += size;
+    }
+
+    dirty.clear();
 }
 
 
 // -------------------- Draw --------------------
 void MazeMesh::draw(Shader& shader) const {
-    if (m_vertexCount == 0) return;
+    shader.setMat4("uModel", glm::mat4(1.0f));
+    for (uint32_t c = 0; c < m_chunks.size(); ++c)
+        drawChunk(c);
+}
 
+size_t MazeMesh::draw(Shader& shader, const Frustum& frustum) const
+{
     shader.setMat4("uModel", glm::mat4(1.0f));
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
-    glBindVertexArray(0);
+
+    size_t drawn = 0;
+    for (uint32_t c = 0; c < m_chunks.size(); ++c) {
+        if (frustum.intersects(m_chunks[c].min, m_chunks[c].max) && drawChunk(c))
+            ++drawn;
+    }
+    return drawn;
 }
 
+bool MazeMesh::drawChunk(uint32_t c) const
+{
+    if (c >= m_buffers.size()) return false;
 
+    const ChunkBuffers& gpu = m_buffers[c];
+    if (gpu.indexCount == 0 || !gpu.vao) return false;
 
+    glBindVertexArray(gpu.vao);
+    glDrawElements(GL_TRIANGLES, gpu.indexCount, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+    return true;
+}
 
 
-// -------------------- Rebuild Single Cell --------------------
-void MazeMesh::rebuildCell(int x, int y, const Maze& maze)
+// -------------------- Wall Slots --------------------
+size_t MazeMesh::wallIndex(int x, int y, Direction dir) const
 {
-    constexpr float CELL_SIZE      = 1.0f;
-    constexpr float WALL_HEIGHT    = 1.0f;
-    constexpr float WALL_THICKNESS = 0.1f;
-    float h = WALL_HEIGHT * 0.5f;
-    float t = WALL_THICKNESS * 0.5f;
+    switch (dir)
+    {
+        case North: return horizontalWall(x, y);
+        case South: return horizontalWall(x, y + 1);
+        case West:  return verticalWall(y, x);
+        default:    return verticalWall(y, x + 1);
+    }
+}
 
-    const auto& cell = maze.cell(x, y);
+size_t MazeMesh::horizontalWall(int col, int line) const
+{
+    if (col < 0 || col >= m_width || line < 0 || line > m_height) return NO_WALL;
 
-    float fx = x * CELL_SIZE;
-    float fz = y * CELL_SIZE;
+    const size_t cells = static_cast<size_t>(m_width) * m_height;
+    if (line == m_height) return cells * 2 + col;
+    return (static_cast<size_t>(line) * m_width + col) * 2;
+}
 
-    std::vector<float> newVerts;
+size_t MazeMesh::verticalWall(int row, int line) const
+{
+    if (row < 0 || row >= m_height || line < 0 || line > m_width) return NO_WALL;
 
-    auto pushBox = [&](glm::vec3 center, glm::vec3 half)
-    {
-        glm::vec3 p[8] = {
-            center + glm::vec3(-half.x,-half.y,-half.z),
-            center + glm::vec3( half.x,-half.y,-half.z),
-            center + glm::vec3( half.x, half.y,-half.z),
-            center + glm::vec3(-half.x, half.y,-half.z),
-            center + glm::vec3(-half.x,-half.y, half.z),
-            center + glm::vec3( half.x,-half.y, half.z),
-            center + glm::vec3( half.x, half.y, half.z),
-            center + glm::vec3(-half.x, half.y, half.z)
-        };
-
-        auto tri = [&](int a,int b,int c){
-            newVerts.insert(newVerts.end(), {
-                p[a].x,p[a].y,p[a].z,
-                p[b].x,p[b].y,p[b].z,
-                p[c].x,p[c].y,p[c].z
-            });
-        };
-
-        tri(0,2,1); tri(0,3,2);
-        tri(4,5,6); tri(4,6,7);
-        tri(0,4,7); tri(0,7,3);
-        tri(1,2,6); tri(1,6,5);
-        tri(3,7,6); tri(3,6,2);
-        tri(0,1,5); tri(0,5,4);
-    };
+    const size_t cells = static_cast<size_t>(m_width) * m_height;
+    if (line == m_width) return cells * 2 + m_width + row;
+    return (static_cast<size_t>(row) * m_width + line) * 2 + 1;
+}
 
-    // Always render North + West to avoid duplicates
-    if (cell.walls & North)
-        pushBox({ fx + CELL_SIZE*0.5f, h, fz },
-                { CELL_SIZE*0.5f, h, t });
+size_t MazeMesh::runWall(const WallRun& run, int at) const
+{
+    return run.horizontal ? horizontalWall(at, run.line) : verticalWall(at, run.line);
+}
 
-    if (cell.walls & West)
-        pushBox({ fx, h, fz + CELL_SIZE*0.5f },
-                { t, h, CELL_SIZE*0.5f });
+uint32_t MazeMesh::chunkOf(const WallRun& run, int at) const
+{
+    const int x = run.horizontal ? at : std::min(run.line, m_width - 1);
+    const int y = run.horizontal ? std::min(run.line, m_height - 1) : at;
+    return static_cast<uint32_t>((y / CHUNK_CELLS) * m_chunksX + x / CHUNK_CELLS);
+}
 
-    // Render outer borders
-    if (y == maze.height() - 1 && (cell.walls & South))
-        pushBox({ fx + CELL_SIZE*0.5f, h, fz + CELL_SIZE },
-                { CELL_SIZE*0.5f, h, t });
+void MazeMesh::runEnds(const WallRun& run, int& ax, int& az, int& bx, int& bz)
+{
+    if (run.horizontal) {
+        ax = run.begin; az = run.line;
+        bx = run.end;   bz = run.line;
+    }
+    else {
+        ax = run.line; az = run.begin;
+        bx = run.line; bz = run.end;
+    }
+}
 
-    if (x == maze.width() - 1 && (cell.walls & East))
-        pushBox({ fx + CELL_SIZE, h, fz + CELL_SIZE*0.5f },
-                { t, h, CELL_SIZE*0.5f });
+bool MazeMesh::postTaken(int vx, int vz, const WallRun& run) const
+{
+    WallRun around[4];
+    wallsMeeting(vx, vz, around);
 
-    auto key = std::make_pair(x,y);
+    for (const WallRun& other : around) {
+        const size_t wall = runWall(other, other.begin);
+        if (wall == NO_WALL || m_wallSlot[wall] == NO_SLOT) continue;
 
-    // Remove old data
-    if (m_cellRanges.count(key))
-    {
-        auto old = m_cellRanges[key];
-
-        m_vertices.erase(
-            m_vertices.begin() + old.offset,
-            m_vertices.begin() + old.offset + old.count
-        );
-
-        // Fix offsets of all cells after this one
-        for (auto& [k, range] : m_cellRanges)
-        {
-            if (range.offset > old.offset)
-                range.offset -= old.count;
-        }
+        const bool own = other.horizontal == run.horizontal && other.line == run.line &&
+                         other.begin >= run.begin && other.begin < run.end;
+        if (!own) return true;
     }
+    return false;
+}
 
-    // Insert new data at end
-    size_t newOffset = m_vertices.size();
-    m_vertices.insert(m_vertices.end(), newVerts.begin(), newVerts.end());
+bool MazeMesh::syncWall(int x, int y, Direction dir, const Maze& maze)
+{
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return false;
+
+    const bool present = maze.hasWall(x, y, dir);
+    if (present == (m_wallSlot[wallIndex(x, y, dir)] != NO_SLOT)) return false;
+
+    // The runs either side are already meshed; swap them for the joined
+    // one, or the joined one for the two halves. Only their pieces in the
+    // edited wall's chunk change.
+    const WallEdit edit{ x, y, dir, present };
+    const WallRun segment = wallSegment(edit);
+    const int lo = segment.begin / CHUNK_CELLS * CHUNK_CELLS;
+    const int hi = lo + CHUNK_CELLS;
+    auto clip = [&](const WallRun& run) {
+        return WallRun{ run.horizontal, run.line, std::max(run.begin, lo), std::min(run.end, hi) };
+    };
 
-    m_cellRanges[key] = { newOffset, newVerts.size() };
+    const WallRunEdit change = wallRunEdit(maze, edit);
+    for (const WallRun& run : change.before) {
+        const WallRun piece = clip(run);
+        if (!piece.empty())
+            freeSlot(chunkOf(piece, piece.begin), m_wallSlot[runWall(piece, piece.begin)]);
+    }
+    for (const WallRun& run : change.after) {
+        const WallRun piece = clip(run);
+        if (!piece.empty())
+            writeIndices(chunkOf(piece, piece.begin), addRun(piece));
+    }
 
-    m_vertexCount = static_cast<GLsizei>(m_vertices.size() / 3);
+    refreshEnds(segment);
+    return true;
 }
 
+uint32_t MazeMesh::addRun(const WallRun& run)
+{
+    const uint32_t c = chunkOf(run, run.begin);
+    Chunk& chunk = m_chunks[c];
+
+    const uint32_t slot = static_cast<uint32_t>(chunk.slotRun.size());
+    chunk.slotRun.push_back(run);
+    for (int at = run.begin; at < run.end; ++at)
+        m_wallSlot[runWall(run, at)] = slot;
+    m_wallCount += run.length();
+
+    chunk.vertices.resize(chunk.slotRun.size() * FLOATS_PER_BOX);
+    chunk.indices.resize(chunk.slotRun.size() * m_indicesPerSlot);
+    chunk.slotTriangles.push_back(0);
+    writeBox(c, slot);
+    return slot;
+}
 
-// -------------------- Edit Single Wall --------------------
-void MazeMesh::editWall(const Maze& maze, const WallEdit& edit)
+void MazeMesh::freeSlot(uint32_t c, uint32_t slot)
 {
-    // Rebuild edited cell
-    rebuildCell(edit.x, edit.y, maze);
+    Chunk& chunk = m_chunks[c];
+    const uint32_t last = static_cast<uint32_t>(chunk.slotRun.size() - 1);
+    const WallRun& run = chunk.slotRun[slot];
+    for (int at = run.begin; at < run.end; ++at)
+        m_wallSlot[runWall(run, at)] = NO_SLOT;
+    m_wallCount -= run.length();
+    chunk.triangles -= chunk.slotTriangles[slot];
+
+    // Keep the live slots packed: the last one moves into the hole. Its
+    // indices are rebased onto the new slot's corners.
+    if (slot != last) {
+        std::copy_n(&chunk.vertices[last * FLOATS_PER_BOX], FLOATS_PER_BOX, &chunk.vertices[slot * FLOATS_PER_BOX]);
+        chunk.slotRun[slot] = chunk.slotRun[last];
+        const WallRun& moved = chunk.slotRun[slot];
+        for (int at = moved.begin; at < moved.end; ++at)
+            m_wallSlot[runWall(moved, at)] = slot;
+        chunk.slotTriangles[slot] = chunk.slotTriangles[last];
+
+        const uint32_t shift = (last - slot) * CORNERS;
+        for (size_t i = 0; i < m_indicesPerSlot; ++i)
+            chunk.indices[slot * m_indicesPerSlot + i] = chunk.indices[last * m_indicesPerSlot + i] - shift;
+
+        markDirty(c, chunk.dirtyVertices, slot);
+        markDirty(c, chunk.dirtyIndices, slot);
+    }
+    else {
+        // Nothing to send, but the chunk now draws one slot fewer
+        markDirty(c, chunk.dirtyIndices, slot);
+    }
 
-    // Rebuild neighbor if wall is shared
-    switch (edit.dir)
-    {
-        case North:
-            if (edit.y > 0)
-                rebuildCell(edit.x, edit.y - 1, maze);
-            break;
+    chunk.slotRun.pop_back();
+    chunk.slotTriangles.pop_back();
+    chunk.vertices.resize(chunk.slotRun.size() * FLOATS_PER_BOX);
+    chunk.indices.resize(chunk.slotRun.size() * m_indicesPerSlot);
+}
+
+void MazeMesh::markDirty(uint32_t c, std::vector<uint32_t>& dirty, uint32_t slot)
+{
+    const Chunk& chunk = m_chunks[c];
+    if (chunk.dirtyVertices.empty() && chunk.dirtyIndices.empty())
+        m_dirtyChunks.push_back(c);
+    dirty.push_back(slot);
+}
 
-        case West:
-            if (edit.x > 0)
-                rebuildCell(edit.x - 1, edit.y, maze);
-            break;
+void MazeMesh::writeBox(uint32_t c, uint32_t slot)
+{
+    Chunk& chunk = m_chunks[c];
+    boxVertices(chunk.slotRun[slot], &chunk.vertices[slot * FLOATS_PER_BOX]);
+    markDirty(c, chunk.dirtyVertices, slot);
+}
 
-        case South:
-            if (edit.y < maze.height() - 1)
-                rebuildCell(edit.x, edit.y + 1, maze);
-            break;
+void MazeMesh::boxVertices(const WallRun& run, float* out) const
+{
+    const float cell = m_config.cellSize;
+    const float h = m_config.wallHeight * 0.5f;
+    const float t = m_config.wallThickness * 0.5f;
+
+    // Runs from its first grid vertex to its last, plus half a thickness
+    // past each so it overlaps whatever meets it there
+    int ax, az, bx, bz;
+    runEnds(run, ax, az, bx, bz);
+
+    const float along = run.length() * cell * 0.5f + t;
+    const glm::vec3 a((m_originX + ax) * cell, h, (m_originY + az) * cell);
+    const glm::vec3 b((m_originX + bx) * cell, h, (m_originY + bz) * cell);
+    const glm::vec3 center = (a + b) * 0.5f;
+    const glm::vec3 half = run.horizontal ? glm::vec3(along, h, t)
+                                          : glm::vec3(t, h, along);
+
+    glm::vec3 p[CORNERS] = {
+        center + glm::vec3(-half.x,-half.y,-half.z),
+        center + glm::vec3( half.x,-half.y,-half.z),
+        center + glm::vec3( half.x, half.y,-half.z),
+        center + glm::vec3(-half.x, half.y,-half.z),
+        center + glm::vec3(-half.x,-half.y, half.z),
+        center + glm::vec3( half.x,-half.y, half.z),
+        center + glm::vec3( half.x, half.y, half.z),
+        center + glm::vec3(-half.x, half.y, half.z)
+    };
 
-        case East:
-            if (edit.x < maze.width() - 1)
-                rebuildCell(edit.x + 1, edit.y, maze);
-            break;
+    for (const glm::vec3& v : p) {
+        *out++ = v.x;
+        *out++ = v.y;
+        *out++ = v.z;
     }
+}
 
-    // Update GPU once after all changes
-    m_vertexCount = static_cast<GLsizei>(m_vertices.size() / 3);
+void MazeMesh::writeIndices(uint32_t c, uint32_t slot)
+{
+    Chunk& chunk = m_chunks[c];
+    uint32_t indices[MAX_FACES * 6];
+    const int count = slotIndices(chunk.slotRun[slot], slot, indices);
+
+    uint32_t* dst = &chunk.indices[slot * m_indicesPerSlot];
+    if (std::equal(indices, indices + m_indicesPerSlot, dst) && chunk.slotTriangles[slot] == count * 2)
+        return;
+
+    std::copy_n(indices, m_indicesPerSlot, dst);
+    chunk.triangles = chunk.triangles - chunk.slotTriangles[slot] + count * 2;
+    chunk.slotTriangles[slot] = static_cast<uint8_t>(count * 2);
+    markDirty(c, chunk.dirtyIndices, slot);
+}
 
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 m_vertices.size() * sizeof(float),
-                 m_vertices.data(),
-                 GL_DYNAMIC_DRAW);
+int MazeMesh::slotIndices(const WallRun& run, uint32_t slot, uint32_t* out) const
+{
+    const bool alongX = run.horizontal;
+
+    int ax, az, bx, bz;
+    runEnds(run, ax, az, bx, bz);
+
+    // Sides face across the wall; caps face along it, toward a and b
+    Face faces[MAX_FACES];
+    int count = 0;
+    faces[count++] = alongX ? FACE_NEG_Z : FACE_NEG_X;
+    faces[count++] = alongX ? FACE_POS_Z : FACE_POS_X;
+    if (!postTaken(ax, az, run)) faces[count++] = alongX ? FACE_NEG_X : FACE_NEG_Z;
+    if (!postTaken(bx, bz, run)) faces[count++] = alongX ? FACE_POS_X : FACE_POS_Z;
+    if (!m_config.ceiling) faces[count++] = FACE_TOP;
+
+    const uint32_t base = slot * static_cast<uint32_t>(CORNERS);
+    size_t n = 0;
+    for (int f = 0; f < count; ++f)
+        for (uint32_t corner : FACE_INDICES[faces[f]])
+            out[n++] = base + corner;
+
+    // Pad with degenerate triangles
+    while (n < m_indicesPerSlot)
+        out[n++] = base;
+    return count;
+}
+
+void MazeMesh::refreshEnds(const WallRun& segment)
+{
+    int ends[2][2];
+    runEnds(segment, ends[0][0], ends[0][1], ends[1][0], ends[1][1]);
+
+    // Only runs ending at one of these vertices have a cap there, but
+    // re-indexing a run that passes through is a cheap no-op
+    for (const auto& end : ends) {
+        WallRun around[4];
+        wallsMeeting(end[0], end[1], around);
+
+        for (const WallRun& other : around) {
+            const size_t wall = runWall(other, other.begin);
+            if (wall != NO_WALL && m_wallSlot[wall] != NO_SLOT)
+                writeIndices(chunkOf(other, other.begin), m_wallSlot[wall]);
+        }
+    }
+}
+
+
+// -------------------- Edit Single Wall --------------------
+void MazeMesh::editWall(const Maze& maze, const WallEdit& edit)
+{
+    if (m_wallSlot.empty()) return;
+    if (edit.x < 0 || edit.y < 0 || edit.x >= m_width || edit.y >= m_height) return;
+
+    m_lastUploadBytes = 0;
+    syncWall(edit.x, edit.y, edit.dir, maze);
+    uploadDirty();
 }
 
-void engine::MazeMesh::editCell(int x, int y, const Maze& maze) {
-    rebuildCell(x, y, maze);
+void MazeMesh::editCell(int x, int y, const Maze& maze)
+{
+    if (m_wallSlot.empty()) return;
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+
+    m_lastUploadBytes = 0;
+    for (Direction dir : { North, East, South, West })
+        syncWall(x, y, dir, maze);
+    uploadDirty();
 }
 
 } // namespace engine
@@ -0,0 +1,75 @@
+#include "engine/maze/MazePathBatch.h"
+#include "engine/maze/Maze.h"
+#include "engine/core/ThreadPool.h"
+
+#include <algorithm>
+
+namespace engine {
+
+MazeBatchSolver::MazeBatchSolver(ThreadPool& pool, MazeSolver::Method method)
+    : m_pool(pool), m_method(method)
+{
+    m_workers.reserve(pool.size());
+    for (unsigned i = 0; i < pool.size(); ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+}
+
+MazeBatchSolver::~MazeBatchSolver() = default;
+
+size_t MazeBatchSolver::solve(const Maze& maze, std::span<const PathQuery> queries, PathArena& arena)
+{
+    for (auto& w : m_workers) {
+        w->steps.clear();
+        w->expanded = 0;
+    }
+    m_slots.resize(queries.size());
+
+    // --- Solve: each worker appends to its own buffer ---
+    m_pool.parallelFor(queries.size(), [&](size_t i, unsigned worker) {
+        Worker& w = *m_workers[worker];
+        const PathQuery& q = queries[i];
+
+        w.solver.findPath(maze, q.startX, q.startY, q.goalX, q.goalY, w.path, m_method);
+        w.expanded += w.solver.lastExpanded();
+
+        m_slots[i] = { worker, static_cast<uint32_t>(w.path.size()), w.steps.size() };
+        w.steps.insert(w.steps.end(), w.path.begin(), w.path.end());
+    });
+
+    // --- Gather in query order ---
+    arena.m_offsets.resize(queries.size() + 1);
+    arena.m_offsets[0] = 0;
+    size_t found = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        arena.m_offsets[i + 1] = arena.m_offsets[i] + m_slots[i].length;
+        if (m_slots[i].length) ++found;
+    }
+
+    arena.m_steps.resize(arena.m_offsets.back());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const Slot& s = m_slots[i];
+        const auto* src = m_workers[s.worker]->steps.data() + s.offset;
+        std::copy(src, src + s.length, arena.m_steps.begin() + arena.m_offsets[i]);
+    }
+
+    return found;
+}
+
+size_t MazeBatchSolver::lastExpanded() const
+{
+    size_t total = 0;
+    for (const auto& w : m_workers)
+        total += w->expanded;
+    return total;
+}
+
+size_t MazeBatchSolver::scratchBytes() const
+{
+    size_t bytes = m_slots.capacity() * sizeof(Slot);
+    for (const auto& w : m_workers)
+        bytes += sizeof(Worker) + w->solver.scratchBytes()
+               + (w->path.capacity() + w->steps.capacity()) * sizeof(MazeSolver::Step);
+    return bytes;
+}
+
+} // namespace engine
@@ -0,0 +1,149 @@
+#include "engine/maze/MazeRaycast.h"
+#include "engine/maze/Maze.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace engine {
+
+namespace {
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+bool bit(const uint64_t* row, int x)
+{
+    return (row[x >> 6] >> (x & 63)) & 1u;
+}
+
+} // namespace
+
+MazeRayHit raycast(const Maze& maze, const MazeRay& ray)
+{
+    MazeRayHit result;
+
+    const int width = maze.width();
+    const int height = maze.height();
+
+    const float length = std::sqrt(ray.dirX * ray.dirX + ray.dirY * ray.dirY);
+    if (length == 0.0f || width == 0 || height == 0) return result;
+    const float dx = ray.dirX / length;
+    const float dy = ray.dirY / length;
+
+    // --- Clip to the maze; a ray from outside starts on the border ---
+    // Cells are half-open, so x = 0 is inside and x = width is not
+    float t = 0.0f;
+    int enterAxis = -1;
+    const float origin[2] = { ray.x, ray.y };
+    const float dir[2] = { dx, dy };
+    const float size[2] = { static_cast<float>(width), static_cast<float>(height) };
+
+    if (ray.x < 0.0f || ray.x >= size[0] || ray.y < 0.0f || ray.y >= size[1]) {
+        float tExit = ray.maxDistance;
+        for (int a = 0; a < 2; ++a) {
+            const bool out = origin[a] < 0.0f || origin[a] >= size[a];
+            if (dir[a] == 0.0f) {
+                if (out) return result;
+                continue;
+            }
+            float t0 = (0.0f - origin[a]) / dir[a];
+            float t1 = (size[a] - origin[a]) / dir[a];
+            if (t0 > t1) std::swap(t0, t1);
+            if (out && t0 >= t) { t = t0; enterAxis = a; }
+            tExit = std::min(tExit, t1);
+        }
+        if (enterAxis < 0 || t > tExit) {
+            result.distance = std::min(ray.maxDistance, t);
+            return result;
+        }
+    }
+
+    int cx = std::clamp(static_cast<int>(std::floor(ray.x + dx * t)), 0, width - 1);
+    int cy = std::clamp(static_cast<int>(std::floor(ray.y + dy * t)), 0, height - 1);
+
+    // Entering from outside crosses the border wall of the first cell
+    if (enterAxis >= 0) {
+        bool wall;
+        Direction side;
+        if (enterAxis == 0) {
+            side = dx > 0.0f ? West : East;
+            wall = dx > 0.0f ? bit(maze.westRow(cy), 0) : maze.eastBorder(cy);
+        }
+        else {
+            side = dy > 0.0f ? North : South;
+            wall = dy > 0.0f ? bit(maze.northRow(0), cx) : maze.southBorder(cx);
+        }
+        if (wall) {
+            result = { true, t, cx, cy, side };
+            return result;
+        }
+    }
+
+    // --- Amanatides-Woo ---
+    const int stepX = dx > 0.0f ? 1 : -1;
+    const int stepY = dy > 0.0f ? 1 : -1;
+    const float invX = dx != 0.0f ? 1.0f / dx : INF;
+    const float invY = dy != 0.0f ? 1.0f / dy : INF;
+    const float deltaX = std::abs(invX);
+    const float deltaY = std::abs(invY);
+    float nextX = dx != 0.0f ? ((stepX > 0 ? cx + 1 : cx) - ray.x) * invX : INF;
+    float nextY = dy != 0.0f ? ((stepY > 0 ? cy + 1 : cy) - ray.y) * invY : INF;
+
+    for (;;) {
+        if (nextX < nextY) {
+            t = nextX;
+            if (t > ray.maxDistance) break;
+
+            // East side is the next cell's West wall, or the border
+            const bool wall = stepX > 0
+                ? (cx + 1 < width ? bit(maze.westRow(cy), cx + 1) : maze.eastBorder(cy))
+                : bit(maze.westRow(cy), cx);
+            if (wall) {
+                result = { true, t, cx, cy, stepX > 0 ? East : West };
+                return result;
+            }
+
+            cx += stepX;
+            if (cx < 0 || cx >= width) break;
+            nextX += deltaX;
+        }
+        else {
+            t = nextY;
+            if (t > ray.maxDistance) break;
+
+            const bool wall = stepY > 0
+                ? (cy + 1 < height ? bit(maze.northRow(cy + 1), cx) : maze.southBorder(cx))
+                : bit(maze.northRow(cy), cx);
+            if (wall) {
+                result = { true, t, cx, cy, stepY > 0 ? South : North };
+                return result;
+            }
+
+            cy += stepY;
+            if (cy < 0 || cy >= height) break;
+            nextY += deltaY;
+        }
+    }
+
+    result.distance = std::min(t, ray.maxDistance);
+    return result;
+}
+
+void raycast(const Maze& maze, std::span<const MazeRay> rays, std::span<MazeRayHit> hits)
+{
+    const size_t count = std::min(rays.size(), hits.size());
+    for (size_t i = 0; i < count; ++i)
+        hits[i] = raycast(maze, rays[i]);
+}
+
+bool lineOfSight(const Maze& maze, float ax, float ay, float bx, float by)
+{
+    const float dx = bx - ax;
+    const float dy = by - ay;
+    const float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance == 0.0f) return true;
+
+    return !raycast(maze, { ax, ay, dx, dy, distance }).hit;
+}
+
+} // namespace engine
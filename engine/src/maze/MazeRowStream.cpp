@@ -0,0 +1,172 @@
+#include "engine/maze/MazeRowStream.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace engine {
+
+namespace {
+constexpr uint32_t NONE = UINT32_MAX;
+}
+
+MazeRowStream::MazeRowStream(int width, uint64_t seed)
+    : m_width(std::max(width, 1)),
+      m_rng(seed),
+      m_parent(m_width),
+      m_carried(m_width, NONE),
+      m_leader(m_width),
+      m_members(m_width),
+      m_chosen(m_width),
+      m_hasDown(m_width),
+      m_down(m_width),
+      m_row(m_width)
+{
+}
+
+uint32_t MazeRowStream::find(uint32_t c)
+{
+    while (m_parent[c] != c) {
+        m_parent[c] = m_parent[m_parent[c]];
+        c = m_parent[c];
+    }
+    return c;
+}
+
+const std::vector<Maze::Cell>& MazeRowStream::nextRow(bool last)
+{
+    if (m_finished)
+        return m_row;
+
+    RandomBits coin(m_rng);
+
+    // Rebuild the row's sets from the cells carried down. Carried cells
+    // are open to the North; everything else starts fully walled.
+    std::fill(m_leader.begin(), m_leader.end(), NONE);
+    for (int x = 0; x < m_width; ++x) {
+        m_parent[x] = x;
+        m_row[x].walls = North | East | South | West;
+
+        if (m_carried[x] == NONE) continue;
+
+        m_row[x].walls &= ~North;
+
+        uint32_t& l = m_leader[m_carried[x]];
+        if (l == NONE) l = x;
+        else m_parent[x] = l;
+    }
+
+    // Join neighbours in different sets (always, on the last row)
+    for (int x = 0; x + 1 < m_width; ++x) {
+        uint32_t a = find(x);
+        uint32_t b = find(x + 1);
+        if (a == b) continue;
+        if (!last && !coin.next()) continue;
+
+        m_parent[b] = a;
+        m_row[x].walls &= ~East;
+        m_row[x + 1].walls &= ~West;
+    }
+
+    ++m_rowsEmitted;
+
+    if (last) {
+        m_finished = true;
+        return m_row;
+    }
+
+    // Carry cells down at random, at least one per set
+    std::fill(m_hasDown.begin(), m_hasDown.end(), 0);
+    std::fill(m_members.begin(), m_members.end(), 0);
+
+    for (int x = 0; x < m_width; ++x) {
+        uint32_t r = find(x);
+        m_parent[x] = r;
+
+        m_down[x] = coin.next();
+        if (m_down[x]) m_hasDown[r] = 1;
+    }
+
+    for (int x = 0; x < m_width; ++x) {
+        uint32_t r = m_parent[x];
+        if (m_hasDown[r]) continue;
+        if (m_rng.below(++m_members[r]) == 0)
+            m_chosen[r] = x;
+    }
+
+    for (int x = 0; x < m_width; ++x) {
+        uint32_t r = m_parent[x];
+        if (!m_hasDown[r] && m_chosen[r] == static_cast<uint32_t>(x))
+            m_down[x] = 1;
+    }
+
+    for (int x = 0; x < m_width; ++x) {
+        if (m_down[x]) {
+            m_carried[x] = m_parent[x];
+            m_row[x].walls &= ~South;
+        }
+        else {
+            m_carried[x] = NONE;
+        }
+    }
+
+    return m_row;
+}
+
+void MazeRowStream::generate(uint64_t rows, const RowSink& sink)
+{
+    for (uint64_t i = 0; i < rows && !m_finished; ++i) {
+        uint64_t y = m_rowsEmitted;
+        const auto& row = nextRow(i + 1 == rows);
+        sink(y, row.data(), m_width);
+    }
+}
+
+void MazeRowStream::fillChunk(Maze& chunk, bool last)
+{
+    const int width = std::min(chunk.width(), m_width);
+
+    chunk.fillWalls();
+
+    for (int y = 0; y < chunk.height(); ++y) {
+        const auto& row = nextRow(last && y == chunk.height() - 1);
+
+        for (int x = 0; x < width; ++x) {
+            uint8_t walls = row[x].walls;
+            if (!(walls & North)) chunk.removeWall(x, y, North);
+            if (!(walls & East))  chunk.removeWall(x, y, East);
+        }
+
+        // South walls are mirrored into the next row's North; only the
+        // chunk's bottom edge has to carry them itself.
+        if (y == chunk.height() - 1) {
+            for (int x = 0; x < width; ++x)
+                if (!(row[x].walls & South)) chunk.removeWall(x, y, South);
+        }
+    }
+}
+
+void MazeRowStream::write(std::ostream& out, uint64_t rows)
+{
+    const uint32_t width = static_cast<uint32_t>(m_width);
+
+    out.write("MZR1", 4);
+    out.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+
+    std::vector<char> bytes(m_width);
+    generate(rows, [&](uint64_t, const Maze::Cell* cells, int w) {
+        for (int x = 0; x < w; ++x)
+            bytes[x] = static_cast<char>(cells[x].walls);
+        out.write(bytes.data(), w);
+    });
+}
+
+size_t MazeRowStream::stateBytes() const
+{
+    return static_cast<size_t>(m_width) *
+        (5 * sizeof(uint32_t) + 2 * sizeof(uint8_t) + sizeof(Maze::Cell));
+}
+
+} // namespace engine
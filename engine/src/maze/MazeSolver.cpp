@@ -0,0 +1,303 @@
+#include "engine/maze/MazeSolver.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace engine {
+
+namespace {
+
+constexpr uint32_t pack(int x, int y) { return (static_cast<uint32_t>(y) << 16) | static_cast<uint32_t>(x); }
+constexpr int cellX(uint32_t c) { return static_cast<int>(c & 0xffffu); }
+constexpr int cellY(uint32_t c) { return static_cast<int>(c >> 16); }
+
+uint32_t step(uint32_t c, Direction dir)
+{
+    switch (dir) {
+        case North: return c - (1u << 16);
+        case South: return c + (1u << 16);
+        case West:  return c - 1;
+        default:    return c + 1;
+    }
+}
+
+Direction opposite(Direction dir)
+{
+    switch (dir) {
+        case North: return South;
+        case South: return North;
+        case West:  return East;
+        default:    return West;
+    }
+}
+
+constexpr Direction DIRECTIONS[] = { North, East, South, West };
+
+// Min-f heap; on ties prefer the deeper node, which reaches the goal sooner
+struct HeapOrder {
+    template <typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+        return a.f != b.f ? a.f > b.f : a.g < b.g;
+    }
+};
+
+} // namespace
+
+const char* MazeSolver::methodName(Method method)
+{
+    switch (method) {
+        case Method::BFS:           return "bfs";
+        case Method::Bidirectional: return "bidirectional";
+        case Method::AStar:         return "astar";
+    }
+    return "unknown";
+}
+
+bool MazeSolver::reserve(int width, int height)
+{
+    if (!supports(width, height))
+        return false;
+
+    const size_t cells = static_cast<size_t>(width) * height;
+
+    if (m_closed.width() != width || m_closed.height() != height) {
+        m_closed.resize(width, height);
+        m_closedGoal.resize(width, height);
+    }
+    if (m_parent.size() < cells) m_parent.resize(cells);
+    if (m_queue.size() < cells)  m_queue.resize(cells);
+    return true;
+}
+
+size_t MazeSolver::scratchBytes() const
+{
+    const size_t bitsets = 2 * static_cast<size_t>(m_closed.height()) * m_closed.wordsPerRow() * sizeof(uint64_t);
+    return m_parent.capacity() + m_queue.capacity() * sizeof(uint32_t)
+         + m_heap.capacity() * sizeof(HeapEntry) + bitsets;
+}
+
+bool MazeSolver::findPath(const Maze& maze, int startX, int startY, int goalX, int goalY,
+                          std::vector<Step>& path, Method method)
+{
+    path.clear();
+    m_expanded = 0;
+
+    auto inside = [&](int x, int y) { return x >= 0 && y >= 0 && x < maze.width() && y < maze.height(); };
+    if (!inside(startX, startY) || !inside(goalX, goalY))
+        return false;
+
+    // Larger mazes would alias cells in the 16-bit packing
+    if (!reserve(maze.width(), maze.height()))
+        return false;
+
+    const uint32_t start = pack(startX, startY);
+    const uint32_t goal = pack(goalX, goalY);
+
+    bool found = false;
+    switch (method) {
+        case Method::BFS:
+            found = bfs(maze, start, goal);
+            if (found) trace(maze, goal, 0, path);
+            break;
+
+        case Method::AStar:
+            found = astar(maze, start, goal);
+            if (found) trace(maze, goal, 0, path);
+            break;
+
+        case Method::Bidirectional: {
+            uint32_t meet = start;
+            found = bidirectional(maze, start, goal, meet);
+            if (found) {
+                // start .. meet, then meet's goal-side parents to goal
+                trace(maze, meet, 0, path);
+                std::reverse(path.begin(), path.end());
+                const size_t half = path.size();
+                trace(maze, meet, 4, path);
+                path.erase(path.begin() + half);   // meet appears in both halves
+            }
+            break;
+        }
+    }
+
+    if (method != Method::Bidirectional)
+        std::reverse(path.begin(), path.end());
+    return found;
+}
+
+void MazeSolver::trace(const Maze& maze, uint32_t cell, int shift, std::vector<Step>& path) const
+{
+    const int width = maze.width();
+    for (;;) {
+        path.push_back({ static_cast<uint16_t>(cellX(cell)), static_cast<uint16_t>(cellY(cell)) });
+        const uint8_t back = (m_parent[static_cast<size_t>(cellY(cell)) * width + cellX(cell)] >> shift) & 0xfu;
+        if (!back) break;
+        cell = step(cell, static_cast<Direction>(back));
+    }
+}
+
+// --- BFS ---
+
+bool MazeSolver::bfs(const Maze& maze, uint32_t start, uint32_t goal)
+{
+    const size_t width = maze.width();
+    size_t head = 0, tail = 0;
+
+    m_queue[tail++] = start;
+    m_closed.set(cellX(start), cellY(start));
+    m_parent[cellY(start) * width + cellX(start)] = 0;
+
+    bool found = false;
+    while (head < tail) {
+        const uint32_t c = m_queue[head++];
+        if (c == goal) { found = true; break; }
+
+        const uint8_t open = maze.openings(cellX(c), cellY(c));
+        for (Direction dir : DIRECTIONS) {
+            if (!(open & dir)) continue;
+            const uint32_t n = step(c, dir);
+            const int nx = cellX(n), ny = cellY(n);
+            if (m_closed.test(nx, ny)) continue;
+
+            m_closed.set(nx, ny);
+            m_parent[ny * width + nx] = opposite(dir);
+            m_queue[tail++] = n;
+        }
+    }
+
+    m_expanded = head;
+    for (size_t i = 0; i < tail; ++i)
+        m_closed.reset(cellX(m_queue[i]), cellY(m_queue[i]));
+    return found;
+}
+
+// --- Bidirectional BFS ---
+//
+// Levels are expanded whole, smaller frontier first. Before a level starts
+// the two sides share no cell, so the shortest path is longer than the two
+// depths combined; the first cell one side reaches that the other has seen
+// closes a path exactly one longer, which is therefore shortest.
+
+bool MazeSolver::bidirectional(const Maze& maze, uint32_t start, uint32_t goal, uint32_t& meet)
+{
+    const size_t width = maze.width();
+    const size_t last = static_cast<size_t>(maze.width()) * maze.height() - 1;
+
+    // Start side fills m_queue from the front, goal side from the back
+    size_t headS = 0, tailS = 0;     // m_queue[headS, tailS)
+    size_t headG = 0, tailG = 0;     // m_queue[last - i] for i in [headG, tailG)
+
+    auto parentOf = [&](uint32_t c) -> uint8_t& { return m_parent[cellY(c) * width + cellX(c)]; };
+
+    m_queue[tailS++] = start;
+    m_closed.set(cellX(start), cellY(start));
+    parentOf(start) = 0;
+
+    bool found = false;
+    if (start == goal) {
+        meet = start;
+        found = true;
+    }
+    else {
+        m_queue[last - tailG++] = goal;
+        m_closedGoal.set(cellX(goal), cellY(goal));
+        parentOf(goal) = 0;
+    }
+
+    while (!found && headS < tailS && headG < tailG) {
+        const bool fromStart = (tailS - headS) <= (tailG - headG);
+        MazeBitset& mine = fromStart ? m_closed : m_closedGoal;
+        const MazeBitset& theirs = fromStart ? m_closedGoal : m_closed;
+        const int shift = fromStart ? 0 : 4;
+
+        size_t& head = fromStart ? headS : headG;
+        size_t& tail = fromStart ? tailS : tailG;
+        const size_t levelEnd = tail;
+
+        for (; head < levelEnd && !found; ++head) {
+            const uint32_t c = fromStart ? m_queue[head] : m_queue[last - head];
+            const uint8_t open = maze.openings(cellX(c), cellY(c));
+
+            for (Direction dir : DIRECTIONS) {
+                if (!(open & dir)) continue;
+                const uint32_t n = step(c, dir);
+                const int nx = cellX(n), ny = cellY(n);
+                if (mine.test(nx, ny)) continue;
+
+                uint8_t& parent = parentOf(n);
+                if (theirs.test(nx, ny)) {
+                    parent = static_cast<uint8_t>((parent & (0xf0u >> shift)) | (opposite(dir) << shift));
+                    meet = n;
+                    found = true;
+                    break;
+                }
+
+                mine.set(nx, ny);
+                parent = static_cast<uint8_t>(opposite(dir) << shift);
+                if (fromStart) m_queue[tail++] = n;
+                else           m_queue[last - tail++] = n;
+            }
+        }
+    }
+
+    m_expanded = headS + headG;
+    for (size_t i = 0; i < tailS; ++i)
+        m_closed.reset(cellX(m_queue[i]), cellY(m_queue[i]));
+    for (size_t i = 0; i < tailG; ++i)
+        m_closedGoal.reset(cellX(m_queue[last - i]), cellY(m_queue[last - i]));
+    return found;
+}
+
+// --- A* ---
+//
+// Parents travel in the heap entries and are written when a cell is
+// closed. With a consistent heuristic the first pop of a cell is optimal,
+// so no per-cell g array is needed; stale duplicates are skipped.
+
+bool MazeSolver::astar(const Maze& maze, uint32_t start, uint32_t goal)
+{
+    const size_t width = maze.width();
+    const int gx = cellX(goal), gy = cellY(goal);
+    auto h = [&](uint32_t c) {
+        return static_cast<uint32_t>(std::abs(cellX(c) - gx) + std::abs(cellY(c) - gy));
+    };
+
+    size_t closedCount = 0;
+    m_heap.clear();
+    m_heap.push_back({ h(start), 0, start, 0 });
+
+    bool found = false;
+    while (!m_heap.empty()) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), HeapOrder{});
+        const HeapEntry top = m_heap.back();
+        m_heap.pop_back();
+
+        const int x = cellX(top.cell), y = cellY(top.cell);
+        if (m_closed.test(x, y)) continue;
+
+        m_closed.set(x, y);
+        m_parent[y * width + x] = top.from;
+        m_queue[closedCount++] = top.cell;
+        if (top.cell == goal) { found = true; break; }
+
+        const uint8_t open = maze.openings(x, y);
+        for (Direction dir : DIRECTIONS) {
+            if (!(open & dir)) continue;
+            const uint32_t n = step(top.cell, dir);
+            if (m_closed.test(cellX(n), cellY(n))) continue;
+
+            m_heap.push_back({ top.g + 1 + h(n), top.g + 1, n, static_cast<uint8_t>(opposite(dir)) });
+            std::push_heap(m_heap.begin(), m_heap.end(), HeapOrder{});
+        }
+    }
+
+    m_expanded = closedCount;
+    for (size_t i = 0; i < closedCount; ++i)
+        m_closed.reset(cellX(m_queue[i]), cellY(m_queue[i]));
+    return found;
+}
+
+} // namespace engine
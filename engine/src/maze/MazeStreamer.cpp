@@ -0,0 +1,205 @@
+#include "engine/maze/MazeStreamer.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/core/Random.h"
+#include "engine/core/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace engine {
+
+MazeStreamer::MazeStreamer(ThreadPool& pool, uint64_t seed, int loadRadius,
+                           const std::string& generatorName)
+    : m_pool(pool),
+      m_loadRadius(std::max(loadRadius, 0)),
+      m_shared(std::make_shared<Shared>())
+{
+    m_shared->generator = createMazeGenerator(generatorName);
+    if (!m_shared->generator)
+        throw std::runtime_error("Unknown maze generator: " + generatorName);
+    m_shared->seed = seed;
+}
+
+MazeStreamer::~MazeStreamer()
+{
+    // Queued jobs see the flag and skip their work
+    for (auto& [k, chunk] : m_pending)
+        chunk->cancelled = true;
+}
+
+glm::ivec2 MazeStreamer::chunkAt(const glm::vec3& position)
+{
+    constexpr float CELL_SIZE = 1.0f;
+    return {
+        static_cast<int>(std::floor(position.x / (CELL_SIZE * CHUNK_SIZE))),
+        static_cast<int>(std::floor(position.z / (CELL_SIZE * CHUNK_SIZE)))
+    };
+}
+
+void MazeStreamer::generateChunk(Maze& maze, const MazeGenerator& generator,
+                                 uint64_t seed, int cx, int cy)
+{
+    const uint64_t stream = (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32)
+                          | static_cast<uint32_t>(cy);
+    SplitMix64 rng = SplitMix64::forStream(seed, stream);
+    maze.generate(generator, rng());
+
+    // East / South seams are owned by the neighbours
+    for (int y = 0; y < CHUNK_SIZE; ++y) maze.removeWall(CHUNK_SIZE - 1, y, East);
+    for (int x = 0; x < CHUNK_SIZE; ++x) maze.removeWall(x, CHUNK_SIZE - 1, South);
+
+    // One door through each owned seam
+    maze.removeWall(static_cast<int>(rng.below(CHUNK_SIZE)), 0, North);
+    maze.removeWall(0, static_cast<int>(rng.below(CHUNK_SIZE)), West);
+}
+
+void MazeStreamer::request(int cx, int cy)
+{
+    auto chunk = std::make_shared<Chunk>();
+    chunk->cx = cx;
+    chunk->cy = cy;
+    m_pending.emplace(key(cx, cy), chunk);
+
+    m_pool.submit([shared = m_shared, chunk]() mutable {
+        if (chunk->cancelled) return;
+
+        const int originX = chunk->cx * CHUNK_SIZE;
+        const int originY = chunk->cy * CHUNK_SIZE;
+        generateChunk(chunk->maze, *shared->generator, shared->seed, chunk->cx, chunk->cy);
+        chunk->mesh.buildGeometry(chunk->maze, originX, originY);
+        chunk->collider.build(chunk->maze, originX, originY);
+
+        // Hand over the only reference: once uploaded, the chunk's GL
+        // objects must be destroyed on the main thread
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->finished.push_back(std::move(chunk));
+    });
+}
+
+void MazeStreamer::update(const glm::vec3& focus, int maxUploads)
+{
+    const glm::ivec2 center = chunkAt(focus);
+
+    if (!m_hasCenter || center != m_center) {
+        m_center = center;
+        m_hasCenter = true;
+
+        // Drop everything outside the keep radius
+        const int keep = m_loadRadius + 1;
+        auto outside = [&](const std::shared_ptr<Chunk>& c) {
+            return std::abs(c->cx - center.x) > keep || std::abs(c->cy - center.y) > keep;
+        };
+        std::erase_if(m_loaded, [&](const auto& entry) { return outside(entry.second); });
+        std::erase_if(m_pending, [&](const auto& entry) {
+            if (!outside(entry.second)) return false;
+            entry.second->cancelled = true;
+            return true;
+        });
+
+        // Queue missing chunks, nearest first
+        std::vector<glm::ivec2> wanted;
+        for (int dy = -m_loadRadius; dy <= m_loadRadius; ++dy)
+            for (int dx = -m_loadRadius; dx <= m_loadRadius; ++dx)
+                wanted.push_back({ center.x + dx, center.y + dy });
+
+        std::sort(wanted.begin(), wanted.end(), [&](glm::ivec2 a, glm::ivec2 b) {
+            glm::ivec2 da = a - center, db = b - center;
+            return da.x * da.x + da.y * da.y < db.x * db.x + db.y * db.y;
+        });
+
+        for (glm::ivec2 c : wanted) {
+            int64_t k = key(c.x, c.y);
+            if (!m_loaded.count(k) && !m_pending.count(k))
+                request(c.x, c.y);
+        }
+    }
+
+    // Upload a bounded number of finished chunks; cancelled ones are free
+    std::vector<std::shared_ptr<Chunk>> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        auto& finished = m_shared->finished;
+        size_t taken = 0;
+        while (taken < finished.size() && static_cast<int>(ready.size()) < maxUploads) {
+            auto& chunk = finished[taken++];
+            if (!chunk->cancelled)
+                ready.push_back(std::move(chunk));
+        }
+        finished.erase(finished.begin(), finished.begin() + taken);
+    }
+
+    for (auto& chunk : ready) {
+        const int64_t k = key(chunk->cx, chunk->cy);
+        chunk->mesh.upload();
+        m_pending.erase(k);
+        m_loaded.emplace(k, std::move(chunk));
+    }
+}
+
+void MazeStreamer::draw(Shader& shader) const
+{
+    for (const auto& [k, chunk] : m_loaded)
+        chunk->mesh.draw(shader);
+}
+
+void MazeStreamer::draw(Shader& shader, const Frustum& frustum) const
+{
+    for (const auto& [k, chunk] : m_loaded)
+        chunk->mesh.draw(shader, frustum);
+}
+
+void MazeStreamer::resolve(glm::vec3& position, float radius) const
+{
+    const glm::ivec2 center = chunkAt(position);
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            auto it = m_loaded.find(key(center.x + dx, center.y + dy));
+            if (it != m_loaded.end())
+                it->second->collider.resolve(position, radius);
+        }
+    }
+}
+
+MazeCollider::SweepHit MazeStreamer::sweep(const glm::vec3& start, const glm::vec3& delta,
+                                           float radius) const
+{
+    // Boxes stick out of their chunk by up to a wall thickness; a cell of
+    // margin covers that
+    const glm::vec3 end = start + delta;
+    const glm::vec3 reach(radius + 1.0f, 0.0f, radius + 1.0f);
+    const glm::ivec2 lo = chunkAt(glm::min(start, end) - reach);
+    const glm::ivec2 hi = chunkAt(glm::max(start, end) + reach);
+
+    MazeCollider::SweepHit first;
+    first.position = end;
+    for (int cy = lo.y; cy <= hi.y; ++cy) {
+        for (int cx = lo.x; cx <= hi.x; ++cx) {
+            auto it = m_loaded.find(key(cx, cy));
+            if (it == m_loaded.end()) continue;
+
+            const MazeCollider::SweepHit hit = it->second->collider.sweep(start, delta, radius);
+            if (hit.hit && (!first.hit || hit.time < first.time))
+                first = hit;
+        }
+    }
+    return first;
+}
+
+glm::vec3 MazeStreamer::moveAndSlide(const glm::vec3& start, const glm::vec3& delta, float radius,
+                                     int maxSlides) const
+{
+    auto sweepChunks = [this, radius](const glm::vec3& pos, const glm::vec3& motion) {
+        return sweep(pos, motion, radius);
+    };
+    return MazeCollider::slide(start, delta, maxSlides, sweepChunks);
+}
+
+const Maze* MazeStreamer::chunk(int cx, int cy) const
+{
+    auto it = m_loaded.find(key(cx, cy));
+    return it != m_loaded.end() ? &it->second->maze : nullptr;
+}
+
+} // namespace engine
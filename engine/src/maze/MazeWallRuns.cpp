@@ -0,0 +1,163 @@
+#include "engine/maze/MazeWallRuns.h"
+#include "engine/maze/Maze.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+namespace {
+
+// Word row of horizontal line `line`: a North plane row, or the South border
+const uint64_t* horizontalLine(const Maze& maze, int line)
+{
+    return line < maze.height() ? maze.northRow(line) : maze.southBorderRow();
+}
+
+bool verticalWallAt(const Maze& maze, int line, int row)
+{
+    if (line == maze.width()) return maze.eastBorder(row);
+    return (maze.westRow(row)[line >> 6] >> (line & 63)) & 1u;
+}
+
+// First column at or after `from` whose bit is `wall`, or width
+int nextColumn(const uint64_t* row, int from, int width, bool wall)
+{
+    for (int word = from >> 6; (word << 6) < width; ++word) {
+        uint64_t bits = wall ? row[word] : ~row[word];
+        if (word == (from >> 6)) bits &= ~0ull << (from & 63);
+        if (bits) return std::min(width, (word << 6) + std::countr_zero(bits));
+    }
+    return width;
+}
+
+// One past the last column before `from` with no wall (0 if none)
+int prevGapEnd(const uint64_t* row, int from)
+{
+    for (int word = from >> 6; word >= 0; --word) {
+        uint64_t gaps = ~row[word];
+        if (word == (from >> 6)) gaps &= (2ull << (from & 63)) - 1;
+        if (gaps) return (word << 6) + 63 - std::countl_zero(gaps) + 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+void forEachWallRun(const Maze& maze, const std::function<void(const WallRun&)>& fn)
+{
+    const int width = maze.width();
+    const int height = maze.height();
+
+    // Horizontal: jump between the edges of each run a word at a time
+    for (int line = 0; line <= height; ++line) {
+        const uint64_t* row = horizontalLine(maze, line);
+        for (int x = nextColumn(row, 0, width, true); x < width;) {
+            const int end = nextColumn(row, x, width, false);
+            fn(WallRun{ true, line, x, end });
+            x = nextColumn(row, end, width, true);
+        }
+    }
+
+    // Vertical: walk the rows in order, keeping each line's open run
+    std::vector<int> open(width + 1, -1);
+    for (int y = 0; y <= height; ++y) {
+        for (int line = 0; line <= width; ++line) {
+            const bool wall = y < height && verticalWallAt(maze, line, y);
+            if (wall && open[line] < 0) {
+                open[line] = y;
+            }
+            else if (!wall && open[line] >= 0) {
+                fn(WallRun{ false, line, open[line], y });
+                open[line] = -1;
+            }
+        }
+    }
+}
+
+void forEachWallRun(const Maze& maze, int x0, int y0, int x1, int y1,
+                    const std::function<void(const WallRun&)>& fn)
+{
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, maze.width());
+    y1 = std::min(y1, maze.height());
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const int lastLineY = y1 == maze.height() ? y1 : y1 - 1;
+    const int lastLineX = x1 == maze.width() ? x1 : x1 - 1;
+
+    for (int line = y0; line <= lastLineY; ++line) {
+        const uint64_t* row = horizontalLine(maze, line);
+        for (int x = nextColumn(row, x0, x1, true); x < x1;) {
+            const int end = nextColumn(row, x, x1, false);
+            fn(WallRun{ true, line, x, end });
+            x = nextColumn(row, end, x1, true);
+        }
+    }
+
+    for (int line = x0; line <= lastLineX; ++line) {
+        for (int y = y0; y < y1;) {
+            if (!verticalWallAt(maze, line, y)) {
+                ++y;
+                continue;
+            }
+            const int begin = y;
+            while (++y < y1 && verticalWallAt(maze, line, y)) {}
+            fn(WallRun{ false, line, begin, y });
+        }
+    }
+}
+
+WallRun wallSegment(const WallEdit& edit)
+{
+    switch (edit.dir)
+    {
+        case North: return WallRun{ true,  edit.y,     edit.x, edit.x + 1 };
+        case South: return WallRun{ true,  edit.y + 1, edit.x, edit.x + 1 };
+        case West:  return WallRun{ false, edit.x,     edit.y, edit.y + 1 };
+        default:    return WallRun{ false, edit.x + 1, edit.y, edit.y + 1 };
+    }
+}
+
+WallRunEdit wallRunEdit(const Maze& maze, const WallEdit& edit)
+{
+    const WallRun spot = wallSegment(edit);
+    const int at = spot.begin;
+
+    // The walls either side of the spot, which the edit did not change
+    int begin, end;
+    if (spot.horizontal) {
+        const uint64_t* row = horizontalLine(maze, spot.line);
+        begin = at > 0 ? prevGapEnd(row, at - 1) : 0;
+        end = nextColumn(row, at + 1, maze.width(), false);
+    }
+    else {
+        const int rows = maze.height();
+        begin = at;
+        while (begin > 0 && verticalWallAt(maze, spot.line, begin - 1)) --begin;
+        end = at + 1;
+        while (end < rows && verticalWallAt(maze, spot.line, end)) ++end;
+    }
+
+    const WallRun joined{ spot.horizontal, spot.line, begin, end };
+    const WallRun left{ spot.horizontal, spot.line, begin, at };
+    const WallRun right{ spot.horizontal, spot.line, at + 1, end };
+
+    WallRunEdit change;
+    if (maze.hasWall(edit.x, edit.y, edit.dir)) {
+        change.before[0] = left;
+        change.before[1] = right;
+        change.after[0] = joined;
+    }
+    else {
+        change.before[0] = joined;
+        change.after[0] = left;
+        change.after[1] = right;
+    }
+    return change;
+}
+
+} // namespace engine
@@ -0,0 +1,82 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// Iterative backtracker.
+// Keeps its own stack of cell indices instead of recursing once per cell, so
+// the depth is bounded by memory rather than by the thread stack. Picking a
+// random unvisited neighbour on every visit is equivalent to shuffling the
+// four directions once per cell, and needs no per-step allocation.
+void BacktrackerGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    struct Step {
+        int dx, dy;
+        Direction dir;
+    };
+
+    static constexpr std::array<Step, 4> STEPS = {{
+        { 0, -1, North },
+        { 1,  0, East  },
+        { 0,  1, South },
+        { -1, 0, West  }
+    }};
+
+    const int width  = maze.width();
+    const int height = maze.height();
+    if (width <= 0 || height <= 0) return;
+
+    std::vector<bool> visited(static_cast<size_t>(width) * height, false);
+
+    std::vector<uint32_t> stack;
+    stack.reserve(static_cast<size_t>(width) + height);
+
+    visited[0] = true;
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        uint32_t current = stack.back();
+        int x = static_cast<int>(current % width);
+        int y = static_cast<int>(current / width);
+
+        std::array<uint8_t, 4> open;
+        uint32_t count = 0;
+
+        for (uint8_t i = 0; i < 4; ++i) {
+            int nx = x + STEPS[i].dx;
+            int ny = y + STEPS[i].dy;
+
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            if (visited[static_cast<size_t>(ny) * width + nx]) continue;
+
+            open[count++] = i;
+        }
+
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        const Step& s = STEPS[open[count == 1 ? 0 : rng.below(count)]];
+        uint32_t next = static_cast<uint32_t>((y + s.dy) * width + (x + s.dx));
+
+        maze.removeWall(x, y, s.dir);
+        visited[next] = true;
+
+        stack.push_back(next);
+    }
+}
+
+size_t BacktrackerGenerator::scratchBytes(int width, int height) const
+{
+    size_t cells = static_cast<size_t>(width) * height;
+    // visited bits + worst-case stack depth
+    return cells / 8 + cells * sizeof(uint32_t);
+}
+
+} // namespace engine
@@ -0,0 +1,34 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+// Binary tree.
+// Every cell except the top-left corner opens towards North or West, so
+// each cell links to exactly one parent and the result is a tree.
+void BinaryTreeGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    RandomBits coin(rng);
+
+    for (int y = 0; y < maze.height(); ++y) {
+        for (int x = 0; x < maze.width(); ++x) {
+            bool canNorth = y > 0;
+            bool canWest  = x > 0;
+
+            if (canNorth && canWest)
+                maze.removeWall(x, y, coin.next() ? North : West);
+            else if (canNorth)
+                maze.removeWall(x, y, North);
+            else if (canWest)
+                maze.removeWall(x, y, West);
+        }
+    }
+}
+
+size_t BinaryTreeGenerator::scratchBytes(int /*width*/, int /*height*/) const
+{
+    return 0;
+}
+
+} // namespace engine
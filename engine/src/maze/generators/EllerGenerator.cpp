@@ -0,0 +1,21 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeRowStream.h"
+
+namespace engine {
+
+// Eller's algorithm: the row stream run over the whole maze in one chunk.
+void EllerGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    if (maze.width() <= 0 || maze.height() <= 0) return;
+
+    MazeRowStream stream(maze.width(), rng());
+    stream.fillChunk(maze, true);
+}
+
+size_t EllerGenerator::scratchBytes(int width, int /*height*/) const
+{
+    return MazeRowStream(width, 0).stateBytes();
+}
+
+} // namespace engine
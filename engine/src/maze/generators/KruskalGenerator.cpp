@@ -0,0 +1,76 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace engine {
+
+// Randomized Kruskal.
+// Every interior wall is an edge, encoded as (cell << 1) | isSouth where the
+// edge joins the cell to its East or South neighbour. Shuffled, then joined
+// through a union-find with path halving and union by size.
+void KruskalGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    const int width  = maze.width();
+    const int height = maze.height();
+    const size_t cells = static_cast<size_t>(width) * height;
+    if (cells == 0) return;
+
+    std::vector<uint32_t> edges;
+    edges.reserve(cells * 2);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint32_t c = static_cast<uint32_t>(y * width + x);
+            if (x + 1 < width)  edges.push_back(c << 1);
+            if (y + 1 < height) edges.push_back((c << 1) | 1u);
+        }
+    }
+
+    randomShuffle(edges.begin(), edges.end(), rng);
+
+    std::vector<uint32_t> parent(cells);
+    std::iota(parent.begin(), parent.end(), 0u);
+    std::vector<uint32_t> size(cells, 1u);
+
+    auto find = [&](uint32_t c) {
+        while (parent[c] != c) {
+            parent[c] = parent[parent[c]];
+            c = parent[c];
+        }
+        return c;
+    };
+
+    size_t joined = 0;
+    for (uint32_t e : edges) {
+        uint32_t a = e >> 1;
+        bool south = e & 1u;
+        uint32_t b = south ? a + width : a + 1;
+
+        uint32_t ra = find(a);
+        uint32_t rb = find(b);
+        if (ra == rb) continue;
+
+        if (size[ra] < size[rb]) std::swap(ra, rb);
+        parent[rb] = ra;
+        size[ra] += size[rb];
+
+        maze.removeWall(static_cast<int>(a % width), static_cast<int>(a / width),
+                        south ? South : East);
+
+        if (++joined == cells - 1) break;
+    }
+}
+
+size_t KruskalGenerator::scratchBytes(int width, int height) const
+{
+    size_t cells = static_cast<size_t>(width) * height;
+    // edge list + parent + size
+    return cells * 2 * sizeof(uint32_t) + cells * 2 * sizeof(uint32_t);
+}
+
+} // namespace engine
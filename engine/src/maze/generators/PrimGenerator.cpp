@@ -0,0 +1,90 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// Randomized Prim.
+// The frontier holds cells adjacent to the carved region; each step moves a
+// random frontier cell into the maze through a random carved neighbour.
+void PrimGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    struct Step {
+        int dx, dy;
+        Direction dir;
+    };
+
+    static constexpr std::array<Step, 4> STEPS = {{
+        { 0, -1, North },
+        { 1,  0, East  },
+        { 0,  1, South },
+        { -1, 0, West  }
+    }};
+
+    const int width  = maze.width();
+    const int height = maze.height();
+    const size_t cells = static_cast<size_t>(width) * height;
+    if (cells == 0) return;
+
+    std::vector<bool> inMaze(cells, false);
+    std::vector<bool> inFrontier(cells, false);
+    std::vector<uint32_t> frontier;
+    frontier.reserve(static_cast<size_t>(width) + height);
+
+    auto addNeighbours = [&](int x, int y) {
+        for (const Step& s : STEPS) {
+            int nx = x + s.dx;
+            int ny = y + s.dy;
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+
+            size_t n = static_cast<size_t>(ny) * width + nx;
+            if (inMaze[n] || inFrontier[n]) continue;
+
+            inFrontier[n] = true;
+            frontier.push_back(static_cast<uint32_t>(n));
+        }
+    };
+
+    inMaze[0] = true;
+    addNeighbours(0, 0);
+
+    while (!frontier.empty()) {
+        size_t pick = rng.below(static_cast<uint32_t>(frontier.size()));
+        uint32_t c = frontier[pick];
+        frontier[pick] = frontier.back();
+        frontier.pop_back();
+
+        int x = static_cast<int>(c % width);
+        int y = static_cast<int>(c / width);
+
+        std::array<uint8_t, 4> carved;
+        uint32_t count = 0;
+        for (uint8_t i = 0; i < 4; ++i) {
+            int nx = x + STEPS[i].dx;
+            int ny = y + STEPS[i].dy;
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            if (inMaze[static_cast<size_t>(ny) * width + nx])
+                carved[count++] = i;
+        }
+
+        // Every frontier cell touches the maze, so count >= 1
+        maze.removeWall(x, y, STEPS[carved[count == 1 ? 0 : rng.below(count)]].dir);
+
+        inMaze[c] = true;
+        inFrontier[c] = false;
+        addNeighbours(x, y);
+    }
+}
+
+size_t PrimGenerator::scratchBytes(int width, int height) const
+{
+    size_t cells = static_cast<size_t>(width) * height;
+    // two bitsets + worst-case frontier
+    return cells / 4 + cells * sizeof(uint32_t);
+}
+
+} // namespace engine
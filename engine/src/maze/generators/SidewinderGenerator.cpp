@@ -0,0 +1,42 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+namespace engine {
+
+// Sidewinder.
+// Walks each row building runs of East passages; closing a run opens North
+// from one random cell of it. The top row is a single open run.
+void SidewinderGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    RandomBits coin(rng);
+
+    const int width = maze.width();
+
+    for (int y = 0; y < maze.height(); ++y) {
+        int runStart = 0;
+
+        for (int x = 0; x < width; ++x) {
+            bool atEast = (x == width - 1);
+            bool closeRun = atEast || (y > 0 && coin.next());
+
+            if (!closeRun) {
+                maze.removeWall(x, y, East);
+                continue;
+            }
+
+            if (y > 0) {
+                int runLength = x - runStart + 1;
+                maze.removeWall(runStart + static_cast<int>(rng.below(runLength)), y, North);
+            }
+            runStart = x + 1;
+        }
+    }
+}
+
+size_t SidewinderGenerator::scratchBytes(int /*width*/, int /*height*/) const
+{
+    return 0;
+}
+
+} // namespace engine
@@ -0,0 +1,108 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+#include "engine/core/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace engine {
+
+// Tiles are rounded up to whole 64-bit words so that no two tiles ever
+// write the same word of the maze's bit planes.
+TiledMazeGenerator::TiledMazeGenerator(const MazeGenerator& inner, ThreadPool& pool, int tileSize)
+    : m_inner(inner), m_pool(pool), m_tileSize((std::max(tileSize, 1) + 63) / 64 * 64)
+{
+}
+
+void TiledMazeGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    const int width  = maze.width();
+    const int height = maze.height();
+    if (width <= 0 || height <= 0) return;
+
+    const int tilesX = (width  + m_tileSize - 1) / m_tileSize;
+    const int tilesY = (height + m_tileSize - 1) / m_tileSize;
+    const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+
+    // Every tile gets its own stream of one base seed, so the result only
+    // depends on rng and the tile size, never on the thread count
+    const uint64_t tileSeed = rng();
+
+    // Carve every tile independently. Tile walls stay closed, and a tile
+    // only ever writes its own words, so no locking is needed.
+    m_pool.parallelFor(tileCount, [&](size_t t, unsigned) {
+        const int x0 = static_cast<int>(t % tilesX) * m_tileSize;
+        const int y0 = static_cast<int>(t / tilesX) * m_tileSize;
+        const int tw = std::min(m_tileSize, width  - x0);
+        const int th = std::min(m_tileSize, height - y0);
+
+        Maze tile(tw, th);
+        SplitMix64 tileRng = SplitMix64::forStream(tileSeed, t);
+        m_inner.generate(tile, tileRng);
+
+        maze.copyFrom(tile, x0, y0);
+    });
+
+    // Random spanning tree over the tile grid (Kruskal), one door per edge
+    std::vector<uint32_t> edges;
+    edges.reserve(tileCount * 2);
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            uint32_t t = static_cast<uint32_t>(ty * tilesX + tx);
+            if (tx + 1 < tilesX) edges.push_back(t << 1);
+            if (ty + 1 < tilesY) edges.push_back((t << 1) | 1u);
+        }
+    }
+    randomShuffle(edges.begin(), edges.end(), rng);
+
+    std::vector<uint32_t> parent(tileCount);
+    std::iota(parent.begin(), parent.end(), 0u);
+
+    auto find = [&](uint32_t c) {
+        while (parent[c] != c) {
+            parent[c] = parent[parent[c]];
+            c = parent[c];
+        }
+        return c;
+    };
+
+    for (uint32_t e : edges) {
+        uint32_t a = e >> 1;
+        bool south = e & 1u;
+        uint32_t b = south ? a + tilesX : a + 1;
+
+        uint32_t ra = find(a);
+        uint32_t rb = find(b);
+        if (ra == rb) continue;
+        parent[rb] = ra;
+
+        const int x0 = static_cast<int>(a % tilesX) * m_tileSize;
+        const int y0 = static_cast<int>(a / tilesX) * m_tileSize;
+
+        if (south) {
+            int span = std::min(m_tileSize, width - x0);
+            maze.removeWall(x0 + static_cast<int>(rng.below(span)), y0 + m_tileSize - 1, South);
+        }
+        else {
+            int span = std::min(m_tileSize, height - y0);
+            maze.removeWall(x0 + m_tileSize - 1, y0 + static_cast<int>(rng.below(span)), East);
+        }
+    }
+}
+
+size_t TiledMazeGenerator::scratchBytes(int width, int height) const
+{
+    const size_t tileCells = static_cast<size_t>(m_tileSize) * m_tileSize;
+    const size_t tiles = (static_cast<size_t>(width) / m_tileSize + 1) *
+                         (static_cast<size_t>(height) / m_tileSize + 1);
+
+    // One tile maze plus inner scratch per worker, tile-graph union-find
+    return m_pool.size() * (tileCells / 4 +
+                            m_inner.scratchBytes(m_tileSize, m_tileSize)) +
+           tiles * 3 * sizeof(uint32_t);
+}
+
+} // namespace engine
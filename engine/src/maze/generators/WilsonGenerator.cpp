@@ -0,0 +1,84 @@
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// Wilson's algorithm.
+// Random-walks from each cell outside the maze until the walk hits it,
+// remembering only the last exit taken from every cell. Replaying those exits
+// from the start erases the loops, and the remaining path joins the maze.
+void WilsonGenerator::generate(Maze& maze, SplitMix64& rng) const
+{
+    struct Step {
+        int dx, dy;
+        Direction dir;
+    };
+
+    static constexpr std::array<Step, 4> STEPS = {{
+        { 0, -1, North },
+        { 1,  0, East  },
+        { 0,  1, South },
+        { -1, 0, West  }
+    }};
+
+    constexpr uint8_t IN_MAZE = 0xFF;
+
+    const int width  = maze.width();
+    const int height = maze.height();
+    const size_t cells = static_cast<size_t>(width) * height;
+    if (cells == 0) return;
+
+    // Exit direction per cell, or IN_MAZE once joined
+    std::vector<uint8_t> exits(cells, 0);
+    exits[0] = IN_MAZE;
+
+    for (size_t start = 1; start < cells; ++start) {
+        if (exits[start] == IN_MAZE) continue;
+
+        // Walk until we hit the maze
+        int x = static_cast<int>(start % width);
+        int y = static_cast<int>(start / width);
+
+        while (exits[static_cast<size_t>(y) * width + x] != IN_MAZE) {
+            std::array<uint8_t, 4> open;
+            uint32_t count = 0;
+            for (uint8_t i = 0; i < 4; ++i) {
+                int nx = x + STEPS[i].dx;
+                int ny = y + STEPS[i].dy;
+                if (nx >= 0 && ny >= 0 && nx < width && ny < height)
+                    open[count++] = i;
+            }
+
+            uint8_t d = open[count == 1 ? 0 : rng.below(count)];
+            exits[static_cast<size_t>(y) * width + x] = d;
+            x += STEPS[d].dx;
+            y += STEPS[d].dy;
+        }
+
+        // Replay the loop-erased path into the maze
+        x = static_cast<int>(start % width);
+        y = static_cast<int>(start / width);
+
+        while (exits[static_cast<size_t>(y) * width + x] != IN_MAZE) {
+            uint8_t& e = exits[static_cast<size_t>(y) * width + x];
+            const Step& s = STEPS[e];
+
+            maze.removeWall(x, y, s.dir);
+            e = IN_MAZE;
+            x += s.dx;
+            y += s.dy;
+        }
+    }
+}
+
+size_t WilsonGenerator::scratchBytes(int width, int height) const
+{
+    return static_cast<size_t>(width) * height;
+}
+
+} // namespace engine
@@ -0,0 +1,37 @@
+#include "engine/scene/Frustum.h"
+
+namespace engine {
+
+Frustum::Frustum(const glm::mat4& m)
+{
+    // Rows of the matrix (glm is column-major)
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; ++i)
+        row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+
+    m_planes[0] = row[3] + row[0];   // left
+    m_planes[1] = row[3] - row[0];   // right
+    m_planes[2] = row[3] + row[1];   // bottom
+    m_planes[3] = row[3] - row[1];   // top
+#if defined(GLM_FORCE_DEPTH_ZERO_TO_ONE)
+    m_planes[4] = row[2];            // near, clip z in [0, w]
+#else
+    m_planes[4] = row[3] + row[2];   // near, clip z in [-w, w]
+#endif
+    m_planes[5] = row[3] - row[2];   // far
+}
+
+bool Frustum::intersects(const glm::vec3& min, const glm::vec3& max) const
+{
+    for (const glm::vec4& p : m_planes) {
+        // The corner furthest along the plane's normal
+        const glm::vec3 corner(p.x >= 0.0f ? max.x : min.x,
+                               p.y >= 0.0f ? max.y : min.y,
+                               p.z >= 0.0f ? max.z : min.z);
+        if (p.x * corner.x + p.y * corner.y + p.z * corner.z + p.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+} // namespace engine
@@ -1,6 +1,9 @@
 
 #include <iostream>
 #include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -8,6 +11,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "engine/core/ThreadPool.h"
 #include "engine/window/Window.h"
 
 #include "engine/scene/FPSCamera.h"
@@ -20,6 +24,7 @@
 #include "engine/maze/Maze.h"
 #include "engine/maze/MazeMesh.h"
 #include "engine/maze/MazeCollider.h"
+#include "engine/maze/MazeStreamer.h"
 
 #include "app/controllers/FPSController.h"
 #include "app/controllers/ICameraController.h"
@@ -34,8 +39,14 @@ constexpr float WALL_THICKNESS = 0.1f;
 
 static bool g_wireframe = false;
 
-int main()
+int main(int argc, char** argv)
 {
+    // --infinite: stream chunks around the player instead of a fixed maze
+    bool infinite = false;
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--infinite")
+            infinite = true;
+
     try
     {
         // ======================================================
@@ -61,13 +72,26 @@ int main()
         // Maze
         // ======================================================
         Maze maze(10, 10);
-        maze.generate();
-
-        MazeMesh mazeMesh;
-        mazeMesh.build(maze);
 
+        // The ceiling is always drawn here, so wall tops are never seen
+        MazeConfig wallConfig;
+        wallConfig.ceiling = true;
+        MazeMesh mazeMesh(wallConfig);
         MazeCollider collider;
-        collider.build(maze);
+
+        ThreadPool workerPool;
+        std::unique_ptr<MazeStreamer> streamer;
+
+        if (infinite)
+        {
+            streamer = std::make_unique<MazeStreamer>(workerPool, std::random_device{}());
+        }
+        else
+        {
+            maze.generate();
+            mazeMesh.build(maze, 0, 0, &workerPool);
+            collider.build(maze);
+        }
 
         float mazeWidth  = maze.width()  * CELL_SIZE;
         float mazeDepth  = maze.height() * CELL_SIZE;
@@ -130,11 +154,16 @@ int main()
             controller->update(camera, dt, dx, dy);
             glm::vec3 desired = camera.position();
 
-            // Collision
+            // Streaming: queue / drop chunks, upload finished ones
+            if (streamer)
+                streamer->update(desired);
+
+            // Collision. The whole step is swept, so sprinting or a long
+            // frame cannot carry the player through a wall.
             constexpr float PLAYER_RADIUS = 0.25f;
-            glm::vec3 corrected = oldPos;
-            corrected.x = desired.x; collider.resolve(corrected, PLAYER_RADIUS);
-            corrected.z = desired.z; collider.resolve(corrected, PLAYER_RADIUS);
+            const glm::vec3 corrected = streamer
+                ? streamer->moveAndSlide(oldPos, desired - oldPos, PLAYER_RADIUS)
+                : collider.moveAndSlide(oldPos, desired - oldPos, PLAYER_RADIUS);
             camera.setPosition(corrected);
 
             // --------------------------------------------------
@@ -159,6 +188,16 @@ int main()
             glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+            // Floor / ceiling cover the maze, or the streamed area around the player
+            glm::vec2 groundCenter(mazeWidth * 0.5f, mazeDepth * 0.5f);
+            glm::vec2 groundSize(mazeWidth, mazeDepth);
+            if (streamer)
+            {
+                float extent = (2.0f * streamer->loadRadius() + 3) * MazeStreamer::CHUNK_SIZE * CELL_SIZE;
+                groundCenter = { camera.position().x, camera.position().z };
+                groundSize = { extent, extent };
+            }
+
             // floor
             glDisable(GL_CULL_FACE);
             floorShader.bind();
@@ -167,8 +206,8 @@ int main()
 
             boxRenderer.draw(
                 floorShader,
-                glm::vec3(mazeWidth * 0.5f, -0.05f, mazeDepth * 0.5f),
-                glm::vec3(mazeWidth, 0.1f, mazeDepth)
+                glm::vec3(groundCenter.x, -0.05f, groundCenter.y),
+                glm::vec3(groundSize.x, 0.1f, groundSize.y)
             );
 
             // ceiling
@@ -178,8 +217,8 @@ int main()
 
             boxRenderer.draw(
                 ceilingShader,
-                glm::vec3(mazeWidth * 0.5f, WALL_HEIGHT + 0.05f, mazeDepth * 0.5f),
-                glm::vec3(mazeWidth, 0.1f, mazeDepth)
+                glm::vec3(groundCenter.x, WALL_HEIGHT + 0.05f, groundCenter.y),
+                glm::vec3(groundSize.x, 0.1f, groundSize.y)
             );
 
             glEnable(GL_CULL_FACE);
@@ -198,7 +237,11 @@ int main()
             wallShader.setBool("useGlow", true);
             wallShader.setInt("colorMode", 0); // 0=cool, 1=warm, 2=neon
 
-            mazeMesh.draw(wallShader);
+            const Frustum frustum = camera.frustum();
+            if (streamer)
+                streamer->draw(wallShader, frustum);
+            else
+                mazeMesh.draw(wallShader, frustum);
 
             // --------------------------------------------------
             window.swapBuffers();
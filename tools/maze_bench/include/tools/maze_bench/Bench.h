@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace tools::maze_bench {
+
+struct BenchOptions {
+    bool quick = false;   // smaller sizes, for smoke runs
+};
+
+class Timer
+{
+public:
+    Timer() : m_start(std::chrono::steady_clock::now()) {}
+
+    double seconds() const
+    {
+        return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// High-water resident set size of this process, 0 if unavailable.
+size_t peakRssBytes();
+
+std::string formatBytes(size_t bytes);
+
+// Keeps the optimizer from discarding a result.
+void doNotOptimize(const void* p);
+
+// Thread counts the scaling suites report
+inline constexpr unsigned SCALING_THREADS[] = { 1, 2, 4, 8, 16 };
+
+// --- Suites (one per source file) ---
+void runGenerationBench(const BenchOptions& options);
+void runAlgorithmBench(const BenchOptions& options);
+void runParallelBench(const BenchOptions& options);
+void runSolverBench(const BenchOptions& options);
+void runHierarchicalBench(const BenchOptions& options);
+void runBatchBench(const BenchOptions& options);
+void runCollisionBench(const BenchOptions& options);
+void runRaycastBench(const BenchOptions& options);
+void runMeshBench(const BenchOptions& options);
+
+} // namespace tools::maze_bench
@@ -0,0 +1,45 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace tools::maze_bench {
+
+// Every generator over a grid of sizes. Peak RSS is the process high-water
+// mark, so it only grows; the scratch column is each algorithm's own estimate.
+void runAlgorithmBench(const BenchOptions& options)
+{
+    const std::vector<int> sides = options.quick
+        ? std::vector<int>{ 64, 256, 1024 }
+        : std::vector<int>{ 64, 256, 1024, 4096 };
+
+    std::printf("%-12s %-12s %10s %14s %12s %12s\n",
+                "algorithm", "size", "ns/cell", "cells/s", "scratch", "peak RSS");
+
+    for (int side : sides) {
+        for (const auto& name : engine::mazeGeneratorNames()) {
+            auto generator = engine::createMazeGenerator(name);
+            const double cells = double(side) * side;
+
+            engine::Maze maze(side, side);
+            Timer t;
+            maze.generate(*generator, 1);
+            double elapsed = t.seconds();
+            doNotOptimize(&maze);
+
+            char label[32];
+            std::snprintf(label, sizeof(label), "%dx%d", side, side);
+
+            std::printf("%-12s %-12s %10.2f %14.3e %12s %12s\n",
+                        name.c_str(), label,
+                        elapsed * 1e9 / cells, cells / elapsed,
+                        formatBytes(generator->scratchBytes(side, side)).c_str(),
+                        formatBytes(peakRssBytes()).c_str());
+        }
+    }
+}
+
+} // namespace tools::maze_bench
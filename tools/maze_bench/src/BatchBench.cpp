@@ -0,0 +1,64 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/Random.h"
+#include "engine/core/ThreadPool.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/MazePathBatch.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace tools::maze_bench {
+
+// Many agents pathing at once: random start/goal pairs on one perfect maze,
+// solved as a batch. Speedup is relative to the 1-thread pool. One warm-up
+// batch per pool sizes every worker's scratch before timing.
+void runBatchBench(const BenchOptions& options)
+{
+    const int side = options.quick ? 256 : 1024;
+    const int queries = options.quick ? 500 : 2000;
+
+    engine::Maze maze(side, side);
+    maze.generate(engine::EllerGenerator{}, 1);
+
+    engine::SplitMix64 rng(11);
+    std::vector<engine::PathQuery> batch(queries);
+    for (auto& q : batch) {
+        q.startX = static_cast<int>(rng.below(side));
+        q.startY = static_cast<int>(rng.below(side));
+        q.goalX = static_cast<int>(rng.below(side));
+        q.goalY = static_cast<int>(rng.below(side));
+    }
+
+    std::printf("astar, %dx%d, %d queries, %u hardware threads\n",
+                side, side, queries, std::thread::hardware_concurrency());
+    std::printf("%-10s %10s %12s %10s %10s %12s %12s\n",
+                "threads", "time", "queries/s", "speedup", "steals", "arena", "scratch");
+
+    double baseline = 0.0;
+    for (unsigned threads : SCALING_THREADS) {
+        engine::ThreadPool pool(threads);
+        engine::MazeBatchSolver solver(pool);
+        engine::PathArena arena;
+
+        solver.solve(maze, batch, arena);
+
+        const size_t stealsBefore = pool.stealCount();
+        Timer t;
+        solver.solve(maze, batch, arena);
+        double elapsed = t.seconds();
+        doNotOptimize(&arena);
+
+        if (baseline == 0.0) baseline = elapsed;
+
+        std::printf("%-10u %9.3fs %12.1f %9.2fx %10zu %12s %12s\n",
+                    threads, elapsed, queries / elapsed, baseline / elapsed,
+                    pool.stealCount() - stealsBefore,
+                    formatBytes(arena.memoryBytes()).c_str(),
+                    formatBytes(solver.scratchBytes()).c_str());
+    }
+}
+
+} // namespace tools::maze_bench
@@ -0,0 +1,51 @@
+#include "tools/maze_bench/Bench.h"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace tools::maze_bench {
+
+namespace {
+const void* volatile g_sink = nullptr;
+}
+
+size_t peakRssBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    #if defined(__APPLE__)
+        return static_cast<size_t>(usage.ru_maxrss);          // bytes
+    #else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;   // kilobytes
+    #endif
+#endif
+}
+
+std::string formatBytes(size_t bytes)
+{
+    char buf[32];
+    double mb = bytes / (1024.0 * 1024.0);
+    std::snprintf(buf, sizeof(buf), "%.1f MB", mb);
+    return buf;
+}
+
+void doNotOptimize(const void* p)
+{
+    g_sink = p;
+}
+
+} // namespace tools::maze_bench
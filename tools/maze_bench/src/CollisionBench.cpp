@@ -0,0 +1,350 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/Random.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeCollider.h"
+#include "engine/maze/MazeGenerator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace tools::maze_bench {
+
+namespace {
+
+// The collider's resolve before it was indexed by cell: every box, in order
+void resolveLinear(const std::vector<engine::MazeCollider::AABB>& walls, glm::vec3& pos, float radius)
+{
+    for (const auto& wall : walls) {
+        float x = std::max(wall.min.x, std::min(pos.x, wall.max.x));
+        float y = std::max(wall.min.y, std::min(pos.y, wall.max.y));
+        float z = std::max(wall.min.z, std::min(pos.z, wall.max.z));
+        float dx = pos.x - x, dy = pos.y - y, dz = pos.z - z;
+        if (dx * dx + dy * dy + dz * dz >= radius * radius)
+            continue;
+
+        float left  = pos.x - wall.min.x;
+        float right = wall.max.x - pos.x;
+        float front = pos.z - wall.min.z;
+        float back  = wall.max.z - pos.z;
+
+        float minPen = std::min({ left, right, front, back });
+
+        if (minPen == left)  pos.x = wall.min.x - radius;
+        if (minPen == right) pos.x = wall.max.x + radius;
+        if (minPen == front) pos.z = wall.min.z - radius;
+        if (minPen == back)  pos.z = wall.max.z + radius;
+    }
+}
+
+// How far a sphere at pos still overlaps the deepest box it touches
+float penetration(const std::vector<engine::MazeCollider::AABB>& walls, const glm::vec3& pos, float radius)
+{
+    float deepest = 0.0f;
+    for (const auto& wall : walls) {
+        float x = std::max(wall.min.x, std::min(pos.x, wall.max.x));
+        float z = std::max(wall.min.z, std::min(pos.z, wall.max.z));
+        deepest = std::max(deepest, radius - std::hypot(pos.x - x, pos.z - z));
+    }
+    return deepest;
+}
+
+// A crowd of agents pressed against the walls: points near the wall lines
+// so most spheres touch one. Batch resolve (SIMD prefilter on CPUs with
+// AVX2) against the scalar path, which must agree bit for bit.
+void runCrowd(const BenchOptions& options)
+{
+    const int side = options.quick ? 300 : 1000;
+    constexpr int AGENTS = 10000;
+    constexpr int STEPS = 200;
+
+    engine::Maze maze(side, side);
+    maze.generate(engine::EllerGenerator{}, 2);
+
+    engine::MazeCollider collider;
+    collider.build(maze);
+
+    engine::SplitMix64 rng(8);
+    std::vector<glm::vec3> agents(AGENTS);
+    std::vector<float> radii(AGENTS);
+    for (int i = 0; i < AGENTS; ++i) {
+        // Within a radius of a cell edge on one axis, anywhere on the other
+        float edge = static_cast<float>(rng.below(side)) + (rng.below(600) / 1000.0f - 0.3f);
+        float along = rng.below(side * 1000) / 1000.0f;
+        agents[i] = (i & 1) ? glm::vec3(edge, 0.5f, along) : glm::vec3(along, 0.5f, edge);
+        radii[i] = 0.15f + rng.below(200) / 1000.0f;
+    }
+
+    std::printf("\ncrowd: %d agents, %dx%d, radius 0.15-0.35\n", AGENTS, side, side);
+    std::printf("%-10s %12s %14s\n", "path", "ms/step", "agents/s");
+
+    std::vector<glm::vec3> batch(AGENTS);
+    Timer tb;
+    for (int step = 0; step < STEPS; ++step) {
+        batch = agents;
+        collider.resolve(batch, radii);
+    }
+    double batchMs = tb.seconds() * 1000.0 / STEPS;
+    doNotOptimize(batch.data());
+
+    std::vector<glm::vec3> scalar(AGENTS);
+    Timer ts;
+    for (int step = 0; step < STEPS; ++step) {
+        scalar = agents;
+        for (int i = 0; i < AGENTS; ++i)
+            collider.resolveScalar(scalar[i], radii[i]);
+    }
+    double scalarMs = ts.seconds() * 1000.0 / STEPS;
+    doNotOptimize(scalar.data());
+
+    int mismatches = 0, moved = 0;
+    for (int i = 0; i < AGENTS; ++i) {
+        if (batch[i] != scalar[i]) ++mismatches;
+        if (batch[i] != agents[i]) ++moved;
+    }
+
+    // Same crowd on the distance field backend
+    Timer tk;
+    collider.setBackend(engine::MazeCollider::Backend::DistanceField, maze);
+    double bakeMs = tk.seconds() * 1000.0;
+
+    std::vector<glm::vec3> field(AGENTS);
+    Timer tf;
+    for (int step = 0; step < STEPS; ++step) {
+        field = agents;
+        collider.resolve(field, radii);
+    }
+    double fieldMs = tf.seconds() * 1000.0 / STEPS;
+    doNotOptimize(field.data());
+
+    // How deep each field result still overlaps the exact boxes: the
+    // largest radius they leave alone, found by bisection
+    float penetration = 0.0f;
+    for (int i = 0; i < AGENTS; ++i) {
+        float clear = 0.0f, hit = radii[i];
+        for (int k = 0; k < 16; ++k) {
+            const float r = 0.5f * (clear + hit);
+            glm::vec3 p = field[i];
+            collider.resolveScalar(p, r);
+            (p == field[i] ? clear : hit) = r;
+        }
+        penetration = std::max(penetration, radii[i] - clear);
+    }
+
+    Timer te;
+    for (int i = 0; i < 1000; ++i) {
+        engine::WallEdit edit{ static_cast<int>(rng.below(side)), static_cast<int>(rng.below(side)),
+                               static_cast<Direction>(1u << rng.below(4)), (i & 1) == 0 };
+        if (edit.add) maze.addWall(edit.x, edit.y, edit.dir);
+        else maze.removeWall(edit.x, edit.y, edit.dir);
+        collider.editWall(maze, edit);
+    }
+    double editUs = te.seconds() * 1e6 / 1000;
+
+    std::printf("%-10s %12.3f %14.3e\n", "batch", batchMs, AGENTS / (batchMs / 1000.0));
+    std::printf("%-10s %12.3f %14.3e\n", "scalar", scalarMs, AGENTS / (scalarMs / 1000.0));
+    std::printf("%-10s %12.3f %14.3e\n", "sdf", fieldMs, AGENTS / (fieldMs / 1000.0));
+    std::printf("%d of %d agents pushed, %d mismatches\n", moved, AGENTS, mismatches);
+    std::printf("sdf: %d samples/cell, bake %.1f ms, %s in %zu tiles, edit %.1f us, "
+                "max penetration %.4f\n",
+                collider.distanceField().samplesPerCell(), bakeMs,
+                formatBytes(collider.distanceField().memoryBytes()).c_str(),
+                collider.distanceField().tileCount(), editUs, penetration);
+}
+
+// Whether the centre's straight path from a to b passes a wall between two
+// cells of maze (placed at the origin), walking the cells it crosses
+bool crossesWall(const engine::Maze& maze, glm::vec3 a, glm::vec3 b)
+{
+    int x = static_cast<int>(std::floor(a.x));
+    int y = static_cast<int>(std::floor(a.z));
+    const int endX = static_cast<int>(std::floor(b.x));
+    const int endY = static_cast<int>(std::floor(b.z));
+    const float dx = b.x - a.x, dz = b.z - a.z;
+
+    const int stepX = dx > 0 ? 1 : -1;
+    const int stepY = dz > 0 ? 1 : -1;
+    float nextX = dx != 0 ? ((stepX > 0 ? x + 1 : x) - a.x) / dx : 2.0f;
+    float nextY = dz != 0 ? ((stepY > 0 ? y + 1 : y) - a.z) / dz : 2.0f;
+    const float deltaX = dx != 0 ? std::abs(1.0f / dx) : 2.0f;
+    const float deltaY = dz != 0 ? std::abs(1.0f / dz) : 2.0f;
+
+    for (int steps = std::abs(endX - x) + std::abs(endY - y); steps > 0; --steps) {
+        Direction dir;
+        if (nextX < nextY) { dir = stepX > 0 ? East : West; nextX += deltaX; }
+        else               { dir = stepY > 0 ? South : North; nextY += deltaY; }
+
+        if (maze.hasWall(x, y, dir)) return true;
+        if (dir == East || dir == West) x += stepX; else y += stepY;
+    }
+    return false;
+}
+
+// Agents taking one long step each, as with a coarse fixed timestep:
+// resolve() only sees where they land; sweeps see the way there.
+void runMotion(const BenchOptions& options)
+{
+    const int side = options.quick ? 300 : 1000;
+    const int agents = options.quick ? 20000 : 100000;
+    constexpr float RADIUS = 0.25f;
+
+    engine::Maze maze(side, side);
+    maze.generate(engine::EllerGenerator{}, 3);
+
+    engine::MazeCollider collider;
+    collider.build(maze);
+
+    std::printf("\nmotion: %d agents, %dx%d, radius %.2f\n", agents, side, side, RADIUS);
+    std::printf("%-8s %-14s %12s %12s\n", "step", "method", "ns/agent", "tunnelled");
+
+    for (float step : { 0.1f, 0.5f, 2.0f }) {
+        engine::SplitMix64 rng(12);
+        std::vector<glm::vec3> starts(agents), deltas(agents);
+        for (int i = 0; i < agents; ++i) {
+            // Cell centres, so every start is clear of the walls
+            starts[i] = { rng.below(side) + 0.5f, 0.5f, rng.below(side) + 0.5f };
+            float angle = rng.below(62832) / 10000.0f;
+            deltas[i] = { std::cos(angle) * step, 0.0f, std::sin(angle) * step };
+        }
+
+        std::vector<glm::vec3> ends(agents);
+        Timer tr;
+        for (int i = 0; i < agents; ++i) {
+            ends[i] = starts[i] + deltas[i];
+            collider.resolve(ends[i], RADIUS);
+        }
+        double resolveNs = tr.seconds() * 1e9 / agents;
+        int resolveTunnels = 0;
+        for (int i = 0; i < agents; ++i)
+            resolveTunnels += crossesWall(maze, starts[i], ends[i]);
+
+        Timer ts;
+        for (int i = 0; i < agents; ++i)
+            ends[i] = collider.moveAndSlide(starts[i], deltas[i], RADIUS);
+        double sweepNs = ts.seconds() * 1e9 / agents;
+        doNotOptimize(ends.data());
+
+        // Replay the slides to check every leg
+        int sweepTunnels = 0;
+        for (int i = 0; i < agents; ++i) {
+            glm::vec3 pos = starts[i], motion = deltas[i];
+            bool tunnelled = false;
+            for (int leg = 0; leg < 4; ++leg) {
+                auto hit = collider.sweep(pos, motion, RADIUS);
+                tunnelled |= crossesWall(maze, pos, hit.position);
+                pos = hit.position;
+                if (!hit.hit) break;
+                motion = hit.slide;
+            }
+            sweepTunnels += tunnelled;
+        }
+
+        char label[16];
+        std::snprintf(label, sizeof(label), "%.1f", step);
+        std::printf("%-8s %-14s %12.1f %12d\n", label, "resolve", resolveNs, resolveTunnels);
+        std::printf("%-8s %-14s %12.1f %12d\n", label, "moveAndSlide", sweepNs, sweepTunnels);
+    }
+}
+
+} // namespace
+
+// Player-sized spheres at random points of a perfect maze, resolved by the
+// cell-indexed collider and by a linear scan over the same boxes. Where a
+// sphere touches two boxes at a corner the two may push in a different
+// order, but the grid must never leave it deeper in a wall. Then random
+// wall toggles through editWall() against one full rebuild. "walls" is
+// the box count before runs were merged: one box per side of each wall.
+void runCollisionBench(const BenchOptions& options)
+{
+    const std::vector<int> sides = options.quick
+        ? std::vector<int>{ 32, 128, 300 }
+        : std::vector<int>{ 32, 128, 300, 1000 };
+    constexpr float RADIUS = 0.25f;
+
+    std::printf("%-12s %10s %10s %16s %16s %10s %10s %10s %12s\n",
+                "size", "walls", "boxes", "grid queries/s", "linear queries/s", "speedup",
+                "edit", "rebuild", "collider");
+
+    for (int side : sides) {
+        engine::Maze maze(side, side);
+        maze.generate(engine::EllerGenerator{}, 1);
+
+        engine::MazeCollider collider;
+        collider.build(maze);
+        const size_t boxes = collider.wallCount();
+
+        size_t wallSides = 0;
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x)
+                wallSides += std::popcount(maze.cell(x, y).walls);
+
+        engine::SplitMix64 rng(5);
+        std::vector<glm::vec3> points(4096);
+        for (auto& p : points)
+            p = { rng.below(side * 1000) / 1000.0f, 0.5f, rng.below(side * 1000) / 1000.0f };
+
+        // Linear cost grows with the maze; keep its run short
+        const int linearQueries = std::max(16, 4'000'000 / side / side);
+        const int gridQueries = 1'000'000;
+
+        Timer tg;
+        for (int q = 0; q < gridQueries; ++q) {
+            glm::vec3 p = points[q & 4095];
+            collider.resolve(p, RADIUS);
+            doNotOptimize(&p);
+        }
+        double gridRate = gridQueries / tg.seconds();
+
+        const std::vector<engine::MazeCollider::AABB> walls = collider.walls();
+        std::vector<glm::vec3> linear(linearQueries);
+        Timer tl;
+        for (int q = 0; q < linearQueries; ++q) {
+            linear[q] = points[q & 4095];
+            resolveLinear(walls, linear[q], RADIUS);
+        }
+        double linearRate = linearQueries / tl.seconds();
+        doNotOptimize(linear.data());
+
+        int mismatches = 0;
+        for (int q = 0; q < linearQueries; ++q) {
+            glm::vec3 g = points[q & 4095];
+            collider.resolve(g, RADIUS);
+            if (penetration(walls, g, RADIUS) > penetration(walls, linear[q], RADIUS) + 1e-4f)
+                ++mismatches;
+        }
+
+        Timer tb;
+        collider.build(maze);
+        double rebuildMs = tb.seconds() * 1000.0;
+
+        constexpr int EDITS = 20000;
+        Timer te;
+        for (int i = 0; i < EDITS; ++i) {
+            int x = static_cast<int>(rng.below(side));
+            int y = static_cast<int>(rng.below(side));
+            Direction dir = (i & 1) ? North : West;
+
+            engine::WallEdit edit{ x, y, dir, !maze.hasWall(x, y, dir) };
+            if (edit.add) maze.addWall(x, y, dir);
+            else maze.removeWall(x, y, dir);
+            collider.editWall(maze, edit);
+        }
+        double editUs = te.seconds() * 1e6 / EDITS;
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", side, side);
+        std::printf("%-12s %10zu %10zu %16.3e %16.3e %9.0fx %8.3fus %8.2fms %12s%s\n",
+                    label, wallSides, boxes, gridRate, linearRate, gridRate / linearRate,
+                    editUs, rebuildMs,
+                    formatBytes(collider.memoryBytes()).c_str(),
+                    mismatches ? "  MISMATCH" : "");
+    }
+
+    runCrowd(options);
+    runMotion(options);
+}
+
+} // namespace tools::maze_bench
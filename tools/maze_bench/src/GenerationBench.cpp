@@ -0,0 +1,121 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeTypes.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace tools::maze_bench {
+
+namespace {
+
+// The original recursive backtracker, kept here as the baseline. It recurses
+// once per cell, so it is only run on sizes the main thread stack survives.
+struct RecursiveMaze {
+    struct Cell {
+        uint8_t walls;
+        bool visited;
+    };
+
+    int width;
+    int height;
+    std::vector<Cell> cells;
+
+    RecursiveMaze(int w, int h) : width(w), height(h), cells(w * h) {}
+
+    void generate(std::mt19937& rng)
+    {
+        for (auto& c : cells) {
+            c.visited = false;
+            c.walls = North | East | South | West;
+        }
+        carve(0, 0, rng);
+    }
+
+    void carve(int x, int y, std::mt19937& rng)
+    {
+        cells[y * width + x].visited = true;
+
+        struct Step {
+            int dx, dy;
+            Direction dir;
+            Direction opposite;
+        };
+
+        std::vector<Step> dirs = {
+            { 0, -1, North, South },
+            { 1,  0, East,  West  },
+            { 0,  1, South, North },
+            { -1, 0, West,  East  }
+        };
+
+        std::shuffle(dirs.begin(), dirs.end(), rng);
+
+        for (const auto& s : dirs) {
+            int nx = x + s.dx;
+            int ny = y + s.dy;
+
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+
+            auto& next = cells[ny * width + nx];
+            if (next.visited) continue;
+
+            cells[y * width + x].walls &= ~s.dir;
+            next.walls &= ~s.opposite;
+
+            carve(nx, ny, rng);
+        }
+    }
+};
+
+constexpr int RECURSIVE_MAX_SIDE = 128;
+
+} // namespace
+
+void runGenerationBench(const BenchOptions& options)
+{
+    const std::vector<int> sides = options.quick
+        ? std::vector<int>{ 64, 128, 1024 }
+        : std::vector<int>{ 64, 128, 1024, 4096, 16384 };
+
+    std::printf("%-12s %16s %16s %10s %12s\n",
+                "size", "recursive c/s", "iterative c/s", "iter time", "peak RSS");
+
+    for (int side : sides) {
+        const double cells = double(side) * side;
+
+        double recursiveRate = 0.0;
+        if (side <= RECURSIVE_MAX_SIDE) {
+            RecursiveMaze reference(side, side);
+            std::mt19937 rng(1234);
+            Timer t;
+            reference.generate(rng);
+            recursiveRate = cells / t.seconds();
+            doNotOptimize(reference.cells.data());
+        }
+
+        engine::Maze maze(side, side);
+        Timer t;
+        maze.generate(1);
+        double elapsed = t.seconds();
+        doNotOptimize(&maze);
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", side, side);
+
+        char recursive[32];
+        if (recursiveRate > 0.0)
+            std::snprintf(recursive, sizeof(recursive), "%.3e", recursiveRate);
+        else
+            std::snprintf(recursive, sizeof(recursive), "(stack)");
+
+        std::printf("%-12s %16s %16.3e %9.2fs %12s\n",
+                    label, recursive, cells / elapsed, elapsed,
+                    formatBytes(peakRssBytes()).c_str());
+    }
+}
+
+} // namespace tools::maze_bench
@@ -0,0 +1,99 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/Random.h"
+#include "engine/core/ThreadPool.h"
+#include "engine/maze/HierarchicalPathfinder.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/MazeSolver.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace tools::maze_bench {
+
+// HPA* against flat A* on the same random queries, on perfect mazes and on
+// "braided" ones with 10% of walls knocked out (many loops, like a maze
+// after editing). Length is HPA* path length over the optimum.
+void runHierarchicalBench(const BenchOptions& options)
+{
+    struct Case { int side; int queries; };
+    const std::vector<Case> cases = options.quick
+        ? std::vector<Case>{ { 256, 50 }, { 1024, 10 } }
+        : std::vector<Case>{ { 1024, 20 }, { 4096, 10 }, { 16384, 4 } };
+
+    constexpr int CLUSTER = 32;
+    constexpr int EDITS = 200;
+
+    engine::ThreadPool pool;
+
+    std::printf("%-9s %-12s %10s %10s %10s %12s %12s %9s %10s\n",
+                "maze", "size", "build", "nodes", "memory", "hpa q/s", "astar q/s", "length", "edit");
+
+    for (const Case& c : cases) {
+        for (bool braided : { false, true }) {
+            engine::Maze maze(c.side, c.side);
+            maze.generate(engine::EllerGenerator{}, 1);
+
+            engine::SplitMix64 rng(3);
+            if (braided) {
+                const size_t knock = size_t(c.side) * c.side / 10;
+                for (size_t i = 0; i < knock; ++i)
+                    maze.removeWall(rng.below(c.side), rng.below(c.side),
+                                    rng() & 1 ? East : South);
+            }
+
+            engine::HierarchicalPathfinder hpa(CLUSTER);
+            Timer buildTimer;
+            hpa.build(maze, &pool);
+            double buildTime = buildTimer.seconds();
+
+            std::vector<int> ends;
+            for (int i = 0; i < c.queries * 4; ++i)
+                ends.push_back(static_cast<int>(rng.below(c.side)));
+
+            std::vector<engine::MazeSolver::Step> path;
+            size_t hpaLength = 0, optimalLength = 0;
+
+            Timer hpaTimer;
+            for (int q = 0; q < c.queries; ++q) {
+                const int* e = &ends[q * 4];
+                hpa.findPath(maze, e[0], e[1], e[2], e[3], path);
+                hpaLength += path.size();
+            }
+            double hpaTime = hpaTimer.seconds();
+
+            engine::MazeSolver solver;
+            solver.findPath(maze, 0, 0, 0, 0, path);
+            Timer solverTimer;
+            for (int q = 0; q < c.queries; ++q) {
+                const int* e = &ends[q * 4];
+                solver.findPath(maze, e[0], e[1], e[2], e[3], path);
+                optimalLength += path.size();
+            }
+            double solverTime = solverTimer.seconds();
+
+            Timer editTimer;
+            for (int i = 0; i < EDITS; ++i) {
+                engine::WallEdit edit{ static_cast<int>(rng.below(c.side)),
+                                       static_cast<int>(rng.below(c.side)), East, false };
+                maze.removeWall(edit.x, edit.y, edit.dir);
+                hpa.editWall(maze, edit);
+            }
+            double editTime = editTimer.seconds() / EDITS;
+
+            char label[32], edit[32], build[32];
+            std::snprintf(label, sizeof(label), "%dx%d", c.side, c.side);
+            std::snprintf(build, sizeof(build), "%.2fs", buildTime);
+            std::snprintf(edit, sizeof(edit), "%.1fus", editTime * 1e6);
+
+            std::printf("%-9s %-12s %10s %10zu %10s %12.2f %12.2f %8.3fx %10s\n",
+                        braided ? "braided" : "perfect", label, build, hpa.nodeCount(),
+                        formatBytes(hpa.memoryBytes()).c_str(),
+                        c.queries / hpaTime, c.queries / solverTime,
+                        optimalLength ? double(hpaLength) / optimalLength : 1.0, edit);
+        }
+    }
+}
+
+} // namespace tools::maze_bench
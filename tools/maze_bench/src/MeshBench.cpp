@@ -0,0 +1,67 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/ThreadPool.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/MazeMesh.h"
+
+#include <cstdio>
+#include <thread>
+
+namespace tools::maze_bench {
+
+// Wall mesh build (CPU side only; no GL context here) against thread
+// count. Speedup is relative to the 1-thread pool; the serial row builds
+// without a pool. Every row produces the same mesh.
+void runMeshBench(const BenchOptions& options)
+{
+    const int side = options.quick ? 1024 : 4096;
+    const double cells = double(side) * side;
+
+    engine::Maze maze(side, side);
+    maze.generate(engine::EllerGenerator{}, 1);
+
+    {
+        engine::MazeMesh mesh;
+        mesh.buildGeometry(maze);
+        const engine::MazeMesh::Stats s = mesh.stats();
+        std::printf("%dx%d, %zu chunks, %zu boxes, %s, %u hardware threads\n",
+                    side, side, s.chunks, s.boxes, formatBytes(s.bytes).c_str(),
+                    std::thread::hardware_concurrency());
+    }
+    std::printf("%-10s %10s %14s %10s\n", "threads", "time", "cells/s", "speedup");
+
+    {
+        engine::MazeMesh mesh;
+        Timer t;
+        mesh.buildGeometry(maze);
+        double elapsed = t.seconds();
+        doNotOptimize(&mesh);
+        std::printf("%-10s %9.3fs %14.3e %10s\n", "serial", elapsed, cells / elapsed, "-");
+    }
+
+    double baseline = 0.0;
+    for (unsigned threads : SCALING_THREADS) {
+        engine::ThreadPool pool(threads);
+
+        // The first build on fresh workers mostly measures their cold
+        // allocator arenas faulting in pages
+        {
+            engine::MazeMesh warmup;
+            warmup.buildGeometry(maze, 0, 0, &pool);
+        }
+
+        engine::MazeMesh mesh;
+        Timer t;
+        mesh.buildGeometry(maze, 0, 0, &pool);
+        double elapsed = t.seconds();
+        doNotOptimize(&mesh);
+
+        if (baseline == 0.0) baseline = elapsed;
+
+        std::printf("%-10u %9.3fs %14.3e %9.2fx\n",
+                    threads, elapsed, cells / elapsed, baseline / elapsed);
+    }
+}
+
+} // namespace tools::maze_bench
@@ -0,0 +1,51 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/ThreadPool.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+
+#include <cstdio>
+#include <thread>
+
+namespace tools::maze_bench {
+
+// Tiled generation scaling. Speedup is relative to the 1-thread tiled run;
+// the serial row is the plain single-threaded generator for reference.
+void runParallelBench(const BenchOptions& options)
+{
+    const int side = options.quick ? 1024 : 4096;
+    const double cells = double(side) * side;
+
+    std::printf("backtracker, %dx%d, 256x256 tiles, %u hardware threads\n",
+                side, side, std::thread::hardware_concurrency());
+    std::printf("%-10s %10s %14s %10s\n", "threads", "time", "cells/s", "speedup");
+
+    engine::BacktrackerGenerator inner;
+
+    {
+        engine::Maze maze(side, side);
+        Timer t;
+        maze.generate(inner, 1);
+        double elapsed = t.seconds();
+        std::printf("%-10s %9.3fs %14.3e %10s\n", "serial", elapsed, cells / elapsed, "-");
+    }
+
+    double baseline = 0.0;
+    for (unsigned threads : SCALING_THREADS) {
+        engine::ThreadPool pool(threads);
+        engine::TiledMazeGenerator tiled(inner, pool, 256);
+
+        engine::Maze maze(side, side);
+        Timer t;
+        maze.generate(tiled, 1);
+        double elapsed = t.seconds();
+        doNotOptimize(&maze);
+
+        if (baseline == 0.0) baseline = elapsed;
+
+        std::printf("%-10u %9.3fs %14.3e %9.2fx\n",
+                    threads, elapsed, cells / elapsed, baseline / elapsed);
+    }
+}
+
+} // namespace tools::maze_bench
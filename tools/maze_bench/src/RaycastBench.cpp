@@ -0,0 +1,92 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/Random.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/MazeRaycast.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace tools::maze_bench {
+
+namespace {
+
+float unit(engine::SplitMix64& rng)
+{
+    return static_cast<float>(rng() >> 40) * (1.0f / 16777216.0f);
+}
+
+void runRays(const char* label, const engine::Maze& maze, int count, float reach)
+{
+    engine::SplitMix64 rng(5);
+    std::vector<engine::MazeRay> rays(count);
+    for (auto& r : rays) {
+        float angle = unit(rng) * 6.2831853f;
+        r = { unit(rng) * maze.width(), unit(rng) * maze.height(),
+              std::cos(angle), std::sin(angle), reach };
+    }
+    std::vector<engine::MazeRayHit> hits(count);
+
+    engine::raycast(maze, rays, hits);
+
+    Timer t;
+    engine::raycast(maze, rays, hits);
+    double elapsed = t.seconds();
+    doNotOptimize(hits.data());
+
+    size_t blocked = 0;
+    double travelled = 0.0;
+    for (const auto& h : hits) {
+        blocked += h.hit;
+        travelled += h.distance;
+    }
+
+    std::printf("%-14s %5dx%-6d %12.2f %12.2f %9.1f%%\n",
+                label, maze.width(), maze.height(), count / elapsed / 1e6,
+                travelled / count, 100.0 * blocked / count);
+}
+
+} // namespace
+
+// Rays from random points in random directions. Mean distance is how far a
+// ray travels before it stops, so rays/s on the open maze shows the cost per
+// cell crossed; the perfect maze shows the per-ray setup cost.
+void runRaycastBench(const BenchOptions& options)
+{
+    const int side = options.quick ? 256 : 2048;
+    const int count = options.quick ? 200000 : 2000000;
+
+    engine::Maze perfect(side, side);
+    perfect.generate(engine::EllerGenerator{}, 1);
+
+    engine::Maze open(side, side);
+    open.clearWalls();
+
+    std::printf("%-14s %12s %12s %12s %10s\n", "maze", "size", "M rays/s", "mean dist", "blocked");
+    runRays("perfect", perfect, count, 64.0f);
+    runRays("open", open, count, 16.0f);
+    runRays("open", open, count / 4, 256.0f);
+
+    engine::SplitMix64 rng(9);
+    const int pairs = count / 4;
+    std::vector<float> points(static_cast<size_t>(pairs) * 4);
+    for (size_t i = 0; i < points.size(); i += 4) {
+        points[i] = unit(rng) * side;
+        points[i + 1] = unit(rng) * side;
+        points[i + 2] = points[i] + (unit(rng) - 0.5f) * 8.0f;
+        points[i + 3] = points[i + 1] + (unit(rng) - 0.5f) * 8.0f;
+    }
+
+    size_t visible = 0;
+    Timer t;
+    for (size_t i = 0; i < points.size(); i += 4)
+        visible += engine::lineOfSight(perfect, points[i], points[i + 1], points[i + 2], points[i + 3]);
+    double elapsed = t.seconds();
+
+    std::printf("line of sight, perfect %dx%d, pairs within 4 cells: %.2f M/s, %.1f%% visible\n",
+                side, side, pairs / elapsed / 1e6, 100.0 * visible / pairs);
+}
+
+} // namespace tools::maze_bench
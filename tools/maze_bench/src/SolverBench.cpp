@@ -0,0 +1,68 @@
+#include "tools/maze_bench/Bench.h"
+
+#include "engine/core/Random.h"
+#include "engine/maze/Maze.h"
+#include "engine/maze/MazeGenerator.h"
+#include "engine/maze/MazeSolver.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace tools::maze_bench {
+
+// Random start/goal pairs on perfect mazes, so paths are long and unique.
+// Eller builds the large mazes quickly; one warm-up query sizes the scratch
+// before timing.
+void runSolverBench(const BenchOptions& options)
+{
+    struct Case { int side; int queries; };
+    const std::vector<Case> cases = options.quick
+        ? std::vector<Case>{ { 256, 200 }, { 1024, 50 } }
+        : std::vector<Case>{ { 1024, 200 }, { 4096, 20 }, { 16384, 4 } };
+
+    const engine::MazeSolver::Method methods[] = {
+        engine::MazeSolver::Method::BFS,
+        engine::MazeSolver::Method::Bidirectional,
+        engine::MazeSolver::Method::AStar,
+    };
+
+    std::printf("%-14s %-12s %12s %14s %12s %12s\n",
+                "method", "size", "queries/s", "cells/query", "scratch", "peak RSS");
+
+    for (const Case& c : cases) {
+        engine::Maze maze(c.side, c.side);
+        maze.generate(engine::EllerGenerator{}, 1);
+
+        engine::SplitMix64 rng(7);
+        std::vector<int> ends;
+        for (int i = 0; i < c.queries * 4; ++i)
+            ends.push_back(static_cast<int>(rng.below(c.side)));
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", c.side, c.side);
+
+        for (auto method : methods) {
+            engine::MazeSolver solver;
+            std::vector<engine::MazeSolver::Step> path;
+            solver.findPath(maze, 0, 0, c.side - 1, c.side - 1, path, method);
+
+            size_t expanded = 0;
+            Timer t;
+            for (int q = 0; q < c.queries; ++q) {
+                const int* e = &ends[q * 4];
+                solver.findPath(maze, e[0], e[1], e[2], e[3], path, method);
+                expanded += solver.lastExpanded();
+                doNotOptimize(path.data());
+            }
+            double elapsed = t.seconds();
+
+            std::printf("%-14s %-12s %12.2f %14.3e %12s %12s\n",
+                        engine::MazeSolver::methodName(method), label,
+                        c.queries / elapsed, double(expanded) / c.queries,
+                        formatBytes(solver.scratchBytes()).c_str(),
+                        formatBytes(peakRssBytes()).c_str());
+        }
+    }
+}
+
+} // namespace tools::maze_bench
@@ -0,0 +1,58 @@
+#include "tools/maze_bench/Bench.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace tools::maze_bench;
+
+struct Suite {
+    const char* name;
+    void (*run)(const BenchOptions&);
+};
+
+static const Suite SUITES[] = {
+    { "generate",   runGenerationBench },
+    { "algorithms", runAlgorithmBench },
+    { "parallel",   runParallelBench },
+    { "solve",      runSolverBench },
+    { "hpa",        runHierarchicalBench },
+    { "batch",      runBatchBench },
+    { "collide",    runCollisionBench },
+    { "raycast",    runRaycastBench },
+    { "mesh",       runMeshBench },
+};
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    std::string only;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0)
+            options.quick = true;
+        else
+            only = argv[i];
+    }
+
+    bool ran = false;
+    for (const auto& suite : SUITES) {
+        if (!only.empty() && only != suite.name)
+            continue;
+
+        std::cout << "=== " << suite.name << " ===\n";
+        suite.run(options);
+        std::cout << "\n";
+        ran = true;
+    }
+
+    if (!ran) {
+        std::cerr << "Unknown suite '" << only << "'. Available:";
+        for (const auto& suite : SUITES)
+            std::cerr << " " << suite.name;
+        std::cerr << "\n";
+        return 1;
+    }
+
+    return 0;
+}